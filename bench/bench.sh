@@ -0,0 +1,26 @@
+#!/bin/bash
+# Runs every benchmark in bench/ with each interpreter given on the command line
+# (./jazz by default) and prints how long each run took, in seconds.
+
+binaries=("$@")
+[ ${#binaries[@]} -eq 0 ] && binaries=(./jazz)
+
+TIMEFORMAT=%3R
+
+printf "%-16s" ""
+for bin in "${binaries[@]}"
+do
+    printf "%26s" "$(basename "$bin")"
+done
+echo
+
+for file in bench/*.js
+do
+    printf "%-16s" "$(basename "$file" .js)"
+    for bin in "${binaries[@]}"
+    do
+        time=$( { time "$bin" < "$file" > /dev/null 2> /dev/null; } 2>&1 )
+        printf "%26s" "$time"
+    done
+    echo
+done
@@ -0,0 +1,3 @@
+var x = 0.5, sum = 0;
+for (var i = 0; i < 500000; i++) sum += x * 1.5 - 0.25;
+return sum;
@@ -0,0 +1,3 @@
+var sum = 0;
+for (var i = 0; i < 2000000; i++) sum += i;
+return sum;
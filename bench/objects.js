@@ -0,0 +1,8 @@
+var point = {};
+point.x = 0;
+point.y = 0;
+for (var i = 0; i < 300000; i++) {
+  point.x = point.x + 1;
+  point.y = point.x + point.y;
+}
+return point.y;
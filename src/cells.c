@@ -0,0 +1,84 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "cells.h"
+#include "state.h"
+#include "object.h"
+
+/* The number of cells allocated at first.
+   The table doubles in size each time it fills up. */
+#define MIN_CELLS (32)
+
+/* Cell indices are stored in bytecode as jz_indexes. */
+#define MAX_CELLS (1 << (sizeof(jz_index) * 8))
+
+void jz_cells_init(JZ_STATE) {
+  jz->cells.values = malloc(sizeof(jz_val) * MIN_CELLS);
+  jz->cells.names = malloc(sizeof(jz_str*) * MIN_CELLS);
+  jz->cells.length = 0;
+  jz->cells.capacity = MIN_CELLS;
+
+  /* Allocating this might start a GC cycle,
+     which mustn't try to mark it. */
+  jz->cells.indices = NULL;
+  jz->cells.indices = jz_obj_new_bare(jz);
+}
+
+jz_index jz_cell_index(JZ_STATE, jz_str* name) {
+  int found = jz_cell_find(jz, name);
+  jz_index index;
+
+  if (found >= 0) return found;
+  name = jz_str_intern(jz, name);
+
+  if (jz->cells.length == MAX_CELLS) {
+    fprintf(stderr, "Too many global variables.\n");
+    exit(1);
+  }
+
+  if (jz->cells.length == jz->cells.capacity) {
+    jz->cells.capacity *= 2;
+    jz->cells.values =
+      realloc(jz->cells.values, sizeof(jz_val) * jz->cells.capacity);
+    jz->cells.names =
+      realloc(jz->cells.names, sizeof(jz_str*) * jz->cells.capacity);
+  }
+
+  index = jz->cells.length++;
+  JZ_CELL(jz, index) = JZ_HOLE;
+  JZ_CELL_NAME(jz, index) = name;
+  if (jz_gc_write_barrier_active(jz))
+    jz_gc_mark_gray(jz, &name->gc);
+
+  jz_obj_put(jz, jz->cells.indices, name, jz_wrap_small_int(jz, index));
+
+  return index;
+}
+
+int jz_cell_find(JZ_STATE, jz_str* name) {
+  jz_val index = jz_obj_get(jz, jz->cells.indices, name);
+
+  if (index == JZ_UNDEFINED) return -1;
+  return jz_unwrap_int(jz, index);
+}
+
+void jz_cells_mark(JZ_STATE) {
+  size_t i;
+
+  if (jz->cells.indices == NULL) return;
+
+  jz_gc_mark_gray(jz, &jz->cells.indices->gc);
+  for (i = 0; i < jz->cells.length; i++) {
+    jz_gc_mark_gray(jz, &JZ_CELL_NAME(jz, i)->gc);
+    JZ_GC_MARK_VAL_GRAY(jz, JZ_CELL(jz, i));
+  }
+}
+
+void jz_cells_free(JZ_STATE) {
+  free(jz->cells.values);
+  free(jz->cells.names);
+  jz->cells.values = NULL;
+  jz->cells.names = NULL;
+  jz->cells.length = 0;
+  jz->cells.indices = NULL;
+}
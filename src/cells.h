@@ -0,0 +1,51 @@
+/* Global variable cells.
+
+   Every global variable lives in a cell in jz->cells
+   whose index never changes once it's been assigned.
+   The compiler resolves each global name in the code to its cell index,
+   so the VM reads and writes globals without looking up their names.
+
+   The global object keeps its properties in these cells too
+   (see jz_obj in object.h),
+   so setting a property on it from native code (e.g. with jz_def)
+   or with this["name"] is seen by compiled code, and vice versa.
+
+   Names the compiler has seen that don't have a value yet
+   have cells containing JZ_HOLE. */
+
+#ifndef JZ_CELLS_H
+#define JZ_CELLS_H
+
+#include "jazz.h"
+#include "value.h"
+#include "gc.h"
+#include "opcode.h"
+
+/* The value of a cell whose global isn't defined.
+   This is never visible to scripts. */
+#define JZ_HOLE ((jz_val)((jz_ct_hole << 2) + jz_tt_const))
+
+#define JZ_CELL(jz, index) ((jz)->cells.values[(index)])
+#define JZ_CELL_NAME(jz, index) ((jz)->cells.names[(index)])
+
+/* Cells are GC roots, so values stored in them while marking
+   need to be marked separately. */
+#define JZ_CELL_SET(jz, index, val) {           \
+    jz_val tmp = (val);                         \
+    JZ_CELL(jz, index) = tmp;                   \
+    if (jz_gc_write_barrier_active(jz))         \
+      JZ_GC_MARK_VAL_GRAY(jz, tmp);             \
+  }
+
+void jz_cells_init(JZ_STATE);
+
+/* Returns the index of the cell for 'name', creating it if necessary. */
+jz_index jz_cell_index(JZ_STATE, jz_str* name);
+
+/* Returns the index of the cell for 'name', or -1 if there isn't one. */
+int jz_cell_find(JZ_STATE, jz_str* name);
+
+void jz_cells_mark(JZ_STATE);
+void jz_cells_free(JZ_STATE);
+
+#endif
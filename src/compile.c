@@ -8,16 +8,25 @@
 #include "_cons.h"
 #include "traverse.h"
 #include "object.h"
+#include "optimize.h"
+#include "ic.h"
+#include "cells.h"
 
-typedef struct {
+typedef struct variable variable;
+struct variable {
   enum {
     local_var,
     closure_var,
-    global_var
+    global_var,
+    /* A variable from an enclosing function
+       that's copied into the closure (see add_capture). */
+    captured_var
   } type;
   jz_str* name;
   jz_index index;
-} variable;
+  jz_bool assigned; /* See analyze_assignments. */
+  variable* source; /* For captured_var, where the copy comes from. */
+};
 
 typedef struct const_node const_node;
 struct const_node {
@@ -35,8 +44,11 @@ struct comp_state {
   size_t local_vars_length;
   jz_obj* closure_vars;
   size_t closure_vars_length;
+  jz_obj* captures;
+  size_t captures_length;
   const_node* consts;
   size_t consts_length;
+  jz_index ics_length;
 };
 
 #define STATE JZ_STATE, comp_state* state
@@ -55,9 +67,12 @@ static comp_state* comp_state_new(JZ_STATE, comp_state* scope);
 static jz_bytecode* compile(STATE, jz_cons* parse_tree);
 
 static jz_val* consts_to_array(STATE);
+static jz_capture* captures_to_array(STATE);
+static void captures_to_array_iterator(JZ_STATE, jz_str* key, jz_val val, void* data);
 
 static jz_bool init_funcs(JZ_STATE, jz_cons* node, void* data);
 static void analyze_params(STATE, jz_cons* param);
+static jz_bool analyze_assignments(JZ_STATE, jz_cons* node, void* data);
 static jz_bool analyze_vars(JZ_STATE, jz_cons* node, void* data);
 static jz_bool analyze_identifiers(JZ_STATE, jz_cons* node, void* data);
 static void assign_indices_iterator(JZ_STATE, jz_str* key, jz_val val, void* data);
@@ -91,6 +106,7 @@ static void compile_logical_binop(STATE, jz_cons* node, jz_parse_type op, jz_boo
 static void compile_simple_binop(STATE, jz_cons* node, jz_opcode op, jz_bool value);
 static void compile_cond(STATE, jz_cons* node, jz_bool value);
 static void compile_call(STATE, jz_cons* node, jz_bool value);
+static void compile_call_op(STATE, jz_cons* node, jz_opcode op);
 static void compile_func(STATE, jz_cons* node, jz_bool value);
 static void compile_assign_binop(STATE, jz_cons* node, jz_opcode op, jz_bool value);
 static void compile_identifier_assign(STATE, jz_cons* node, jz_opcode op, jz_bool value);
@@ -100,8 +116,10 @@ static jz_val get_literal_value(JZ_STATE, jz_cons* node, jz_bool* success);
 
 static variable* get_var(STATE, jz_str* name, jz_bool from_inner_scope);
 static variable* add_lvar(STATE, jz_str* name);
+static variable* add_capture(STATE, variable* source);
 
 static jz_index add_const(STATE, jz_val value);
+static void push_ic(STATE);
 
 static void jump_to_top_from(STATE, ptrdiff_t index);
 static void jump_to_from_top(STATE, ptrdiff_t index);
@@ -116,11 +134,21 @@ static void free_variable(JZ_STATE, jz_str* key, jz_val val, void* data);
 JZ_DEFINE_VECTOR(jz_ptrdiff, 10)
 JZ_DEFINE_VECTOR(jz_opcode, 20)
 
+/* The parse nodes that analyze_assignments looks at. */
+#define ASSIGNMENT_NODES                                                \
+  17, jz_parse_var, jz_op_assign, jz_op_times_eq, jz_op_div_eq,         \
+    jz_op_mod_eq, jz_op_add_eq, jz_op_sub_eq, jz_op_lshift_eq,          \
+    jz_op_rshift_eq, jz_op_urshift_eq, jz_op_bw_and_eq, jz_op_xor_eq,   \
+    jz_op_bw_or_eq, jz_op_pre_inc, jz_op_pre_dec, jz_op_post_inc,       \
+    jz_op_post_dec
+
 jz_bytecode* jz_compile(JZ_STATE, jz_cons* parse_tree) {
   comp_state* state = comp_state_new(jz, NULL);
 
   jz_traverse_several(jz, parse_tree, analyze_vars, state,
                       2, jz_parse_var, jz_parse_func);
+  jz_traverse_several(jz, parse_tree, analyze_assignments, state,
+                      ASSIGNMENT_NODES);
   jz_traverse_one(jz, parse_tree, init_funcs, state, jz_parse_func);
   jz_traverse_several(jz, parse_tree, analyze_identifiers, state,
                       3, jz_parse_identifier, jz_parse_var, jz_parse_func);
@@ -148,8 +176,11 @@ comp_state* comp_state_new(JZ_STATE, comp_state* scope) {
   state->local_vars_length = 0;
   state->closure_vars = jz_obj_new_bare(jz);
   state->closure_vars_length = 0;
+  state->captures = jz_obj_new_bare(jz);
+  state->captures_length = 0;
   state->consts = NULL;
   state->consts_length = 0;
+  state->ics_length = 0;
 
   return state;
 }
@@ -165,14 +196,19 @@ jz_bytecode* compile(STATE, jz_cons* parse_tree) {
     jz_bytecode* bytecode = (jz_bytecode*)jz_gc_malloc(jz, jz_t_bytecode, sizeof(jz_bytecode));
 
     bytecode->arity = state->arity;
-    bytecode->locals_length = state->local_vars->size;
+    bytecode->locals_length = state->local_vars_length;
     bytecode->closure_vars_length = state->closure_vars_length;
-    bytecode->closure_locals_length = state->closure_vars->size;
-    bytecode->code_length = state->code->next - state->code->values;
-    bytecode->code = calloc(sizeof(jz_opcode), bytecode->code_length);
-    memcpy(bytecode->code, state->code->values, bytecode->code_length);
+    bytecode->closure_locals_length = state->closure_vars_length -
+      (state->scope == NULL ? 0 : state->scope->closure_vars_length);
+    bytecode->captures = captures_to_array(jz, state);
+    bytecode->captures_length = state->captures_length;
     bytecode->consts = consts_to_array(jz, state);
     bytecode->consts_length = state->consts_length;
+    bytecode->ics = calloc(sizeof(jz_ic), state->ics_length);
+    bytecode->ics_length = state->ics_length;
+    bytecode->code_length = state->code->next - state->code->values;
+    bytecode->code = jz_optimize(jz, state->code->values,
+                                 &bytecode->code_length, bytecode->consts);
     bytecode->param_locs = state->param_locs;
 
     free_comp_state(jz, state);
@@ -191,6 +227,23 @@ jz_val* consts_to_array(STATE) {
   return bottom;
 }
 
+jz_capture* captures_to_array(STATE) {
+  jz_capture* captures = calloc(sizeof(jz_capture), state->captures_length);
+
+  jz_obj_each(jz, state->captures, captures_to_array_iterator, captures);
+  return captures;
+}
+
+void captures_to_array_iterator(JZ_STATE, jz_str* key, jz_val val, void* data) {
+  jz_capture* captures = (jz_capture*)data;
+  variable* var = UNVOID(val, variable*);
+
+  assert(var->source->type == local_var ||
+         var->source->type == captured_var);
+  captures[var->index].from_capture = var->source->type == captured_var;
+  captures[var->index].index = var->source->index;
+}
+
 /* Sets cadr.ptr of each func to be that func's comp_state. */
 jz_bool init_funcs(JZ_STATE, jz_cons* node, void* data) {
   comp_state* scope = (comp_state*)data;
@@ -202,6 +255,10 @@ jz_bool init_funcs(JZ_STATE, jz_cons* node, void* data) {
   jz_traverse_several(jz, NODE(CDR(node)), analyze_vars, state,
                       2, jz_parse_var, jz_parse_func);
 
+  /* ...and which of them are ever assigned to... */
+  jz_traverse_several(jz, NODE(CDR(node)), analyze_assignments, state,
+                      ASSIGNMENT_NODES);
+
   /* Then we init sub-funcs, thus figuring out what our closure vars are... */
   jz_traverse_one(jz, NODE(CDR(node)), init_funcs, state, jz_parse_func);
 
@@ -240,6 +297,44 @@ jz_bool analyze_vars(JZ_STATE, jz_cons* node, void* data) {
   return jz_true;
 }
 
+/* Marks the local variables of 'state'
+   that are assigned to somewhere in 'node',
+   other than by being passed in as parameters.
+   This includes assignments in inner functions,
+   even though those might be to other variables of the same name. */
+jz_bool analyze_assignments(JZ_STATE, jz_cons* node, void* data) {
+  comp_state* state = (comp_state*)data;
+  jz_cons* target;
+  variable* var;
+
+  if (ENUM(CAR(node)) == jz_parse_var) {
+    jz_cons* var_node;
+
+    for (var_node = NODE(CDR(node)); var_node != NULL;
+         var_node = NODE(CDR(var_node))) {
+      if (CAR(CDAR(var_node)) == NULL)
+        continue;
+
+      var = jz_obj_get_ptr(jz, state->local_vars, (jz_str*)CAAR(var_node));
+      if (var != NULL)
+        var->assigned = jz_true;
+    }
+
+    return jz_true;
+  }
+
+  target = NODE(CADR(node));
+  if (!JZ_IS_GC_TYPE(CAR(target), jz_t_enum) ||
+      ENUM(CAR(target)) != jz_parse_identifier)
+    return jz_true;
+
+  var = jz_obj_get_ptr(jz, state->local_vars, (jz_str*)CADR(target));
+  if (var != NULL)
+    var->assigned = jz_true;
+
+  return jz_true;
+}
+
 jz_bool analyze_identifiers(JZ_STATE, jz_cons* node, void* data) {
   comp_state* state = (comp_state*)data;
   variable* var;
@@ -406,7 +501,12 @@ void compile_var(STATE, jz_cons* node) {
 void compile_return(STATE, jz_cons* node) {
   if (node == NULL)
     PUSH_OPCODE(jz_oc_end);
-  else {
+  else if (ENUM(CAR(node)) == jz_parse_call) {
+    /* The ret is only reached if the callee couldn't take over this frame
+       (see tail_call in vm.c). */
+    compile_call_op(jz, state, NODE(CDR(node)), jz_oc_tail_call);
+    PUSH_OPCODE(jz_oc_ret);
+  } else {
     compile_expr(jz, state, node, jz_true);
     PUSH_OPCODE(jz_oc_ret);
   }
@@ -649,19 +749,21 @@ variable* compile_identifier(STATE, jz_cons* node, jz_bool value) {
     PUSH_ARG(var->index);
     break;
 
-  case global_var: {
-    jz_index index = add_const(jz, state, var->name);
-
+  case global_var:
     PUSH_OPCODE(jz_oc_load_global);
-    PUSH_ARG(index);
+    PUSH_ARG(var->index);
     break;
-  }
 
   case closure_var:
     PUSH_OPCODE(jz_oc_closure_retrieve);
     PUSH_ARG(var->index);
     break;
 
+  case captured_var:
+    PUSH_OPCODE(jz_oc_capture_retrieve);
+    PUSH_ARG(var->index);
+    break;
+
   default:
     fprintf(stderr, "Unrecognized variable type %d\n", var->type);
     exit(1);
@@ -677,19 +779,21 @@ void compile_identifier_store(STATE, variable* var) {
     PUSH_ARG(var->index);
     break;
 
-  case global_var: {
-    jz_index index = add_const(jz, state, var->name);
-
+  case global_var:
     PUSH_OPCODE(jz_oc_store_global);
-    PUSH_ARG(index);
+    PUSH_ARG(var->index);
     break;
-  }
 
   case closure_var:
     PUSH_OPCODE(jz_oc_closure_store);
     PUSH_ARG(var->index);
     break;
 
+  case captured_var:
+    fprintf(stderr, "Bug: assigning to captured variable %s\n",
+            jz_str_to_chars(jz, var->name));
+    exit(1);
+
   default:
     fprintf(stderr, "Unrecognized variable type %d\n", var->type);
     exit(1);
@@ -877,9 +981,10 @@ void compile_simple_binop(STATE, jz_cons* node, jz_opcode op, jz_bool value) {
   compile_expr(jz, state, NODE(CAR(node)), jz_true);
   compile_expr(jz, state, NODE(CADR(node)), jz_true);
 
-  if (op != jz_oc_noop)
+  if (op != jz_oc_noop) {
     PUSH_OPCODE(op);
-  else if (!value)
+    if (op == jz_oc_index) push_ic(jz, state);
+  } else if (!value)
     PUSH_OPCODE(jz_oc_pop);
 }
 
@@ -903,6 +1008,13 @@ void compile_cond(STATE, jz_cons* node, jz_bool value) {
 }
 
 void compile_call(STATE, jz_cons* node, jz_bool value) {
+  compile_call_op(jz, state, node, jz_oc_call);
+
+  if (!value)
+    PUSH_OPCODE(jz_oc_pop);
+}
+
+void compile_call_op(STATE, jz_cons* node, jz_opcode op) {
   jz_index arg_count = 0;
   jz_cons* arg = NODE(CDR(node));
 
@@ -914,11 +1026,8 @@ void compile_call(STATE, jz_cons* node, jz_bool value) {
     arg = NODE(CDR(arg));
   }
 
-  PUSH_OPCODE(jz_oc_call);
+  PUSH_OPCODE(op);
   PUSH_ARG(arg_count);
-
-  if (!value)
-    PUSH_OPCODE(jz_oc_pop);
 }
 
 void compile_func(STATE, jz_cons* node, jz_bool value) {
@@ -990,6 +1099,7 @@ void compile_index_assign(STATE, jz_cons* node, jz_opcode op, jz_bool value) {
   if (op != jz_oc_noop) {
     PUSH_OPCODE(jz_oc_dup2);
     PUSH_OPCODE(jz_oc_index);
+    push_ic(jz, state);
     base_stack_size++;
   }
 
@@ -1004,6 +1114,7 @@ void compile_index_assign(STATE, jz_cons* node, jz_opcode op, jz_bool value) {
   }
 
   PUSH_OPCODE(jz_oc_index_store);
+  push_ic(jz, state);
 }
 
 /* Get the jz_val of a jz_parse_exprs node if it's just a literal value,
@@ -1029,16 +1140,17 @@ variable* get_var(STATE, jz_str* name, jz_bool from_inner_scope) {
     var = malloc(sizeof(variable));
     var->type = global_var;
     var->name = name;
-    var->index = 0;
-
-    /* Precompute hash code */
-    jz_str_hash(jz, var->name);
-    return var;    
+    var->index = jz_cell_index(jz, name);
+    var->assigned = jz_false;
+    var->source = NULL;
+    return var;
   }
 
   var = jz_obj_get_ptr(jz, state->local_vars, name);
   if (var != NULL) {
-    if (from_inner_scope) {
+    /* Variables that are never assigned to
+       can be copied into closures rather than boxed. */
+    if (from_inner_scope && var->assigned) {
       /* We want to make this a closure var */
       jz_obj_remove(jz, state->local_vars, name, NULL);
       jz_obj_put_ptr(jz, state->closure_vars, name, var);
@@ -1053,8 +1165,15 @@ variable* get_var(STATE, jz_str* name, jz_bool from_inner_scope) {
   if (var != NULL)
     return var;
 
+  var = jz_obj_get_ptr(jz, state->captures, name);
+  if (var != NULL)
+    return var;
+
   /* Neither local nor closure, either defined above or global. */
-  return get_var(jz, state->scope, name, jz_true);
+  var = get_var(jz, state->scope, name, jz_true);
+  if (var->type == local_var || var->type == captured_var)
+    return add_capture(jz, state, var);
+  return var;
 }
 
 variable* add_lvar(STATE, jz_str* name) {
@@ -1066,11 +1185,34 @@ variable* add_lvar(STATE, jz_str* name) {
   node = malloc(sizeof(variable));
   node->type = local_var;
   node->name = name;
+  node->assigned = jz_false;
+  node->source = NULL;
   jz_obj_put_ptr(jz, state->local_vars, name, node);
 
   return node;
 }
 
+/* Gives the closure its own copy of 'source',
+   a variable of an enclosing function that's never assigned to.
+   The copy is made when the closure is (see jz_func_set_scope),
+   so it's always up to date. */
+variable* add_capture(STATE, variable* source) {
+  variable* var = jz_obj_get_ptr(jz, state->captures, source->name);
+
+  if (var != NULL)
+    return var;
+
+  var = malloc(sizeof(variable));
+  var->type = captured_var;
+  var->name = source->name;
+  var->index = state->captures_length++;
+  var->assigned = jz_false;
+  var->source = source;
+  jz_obj_put_ptr(jz, state->captures, source->name, var);
+
+  return var;
+}
+
 jz_index add_const(STATE, jz_val value) {
   const_node* last_node = NULL;
   const_node* node = state->consts;
@@ -1128,9 +1270,17 @@ ptrdiff_t push_placeholder(STATE, size_t size) {
   return index;
 }
 
+/* Allocates a new inline cache (see ic.h)
+   and pushes its index as an argument. */
+void push_ic(STATE) {
+  jz_index index = state->ics_length++;
+  PUSH_ARG(index);
+}
+
 void free_comp_state(STATE) {
   jz_obj_each(jz, state->local_vars, free_variable, NULL);
   jz_obj_each(jz, state->closure_vars, free_variable, NULL);
+  jz_obj_each(jz, state->captures, free_variable, NULL);
 
   while (state->consts != NULL) {
     const_node* old_consts = state->consts;
@@ -1146,10 +1296,11 @@ void free_variable(JZ_STATE, jz_str* key, jz_val val, void* data) {
   free(jz_unwrap_void(jz, val));
 }
 
-void jz_free_bytecode(JZ_STATE, jz_bytecode* this) {
+void jz_finalize_bytecode(JZ_STATE, jz_bytecode* this) {
   if (this == NULL) return;
 
   free(this->code);
   free(this->consts);
-  free(this);
+  free(this->ics);
+  free(this->captures);
 }
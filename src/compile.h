@@ -11,6 +11,15 @@
 #include "vector.h"
 #include "cons.h"
 
+/* Where a closure's copy of a variable comes from
+   when the closure is made:
+   either one of the enclosing function's locals,
+   or one of the enclosing function's own captures. */
+typedef struct {
+  jz_bool from_capture;
+  jz_index index;
+} jz_capture;
+
 typedef struct {
   jz_gc_header gc;
   jz_opcode* code;
@@ -19,9 +28,15 @@ typedef struct {
   size_t locals_length;
   size_t closure_vars_length;
   size_t closure_locals_length;
+  /* Variables of enclosing functions that are never assigned to
+     are copied into each closure rather than boxed. */
+  jz_capture* captures;
+  size_t captures_length;
   jz_byte* param_locs;
   jz_val* consts;
   size_t consts_length;
+  jz_ic* ics; /* The inline caches used by the code (see ic.h). */
+  size_t ics_length;
 } jz_bytecode;
 
 JZ_DECLARE_VECTOR(jz_opcode)
@@ -34,6 +49,6 @@ jz_bytecode* jz_compile(JZ_STATE, jz_cons* parse_tree);
 
 /* Frees a jz_bytecode*.
    Does nothing if 'this' is NULL. */
-void jz_free_bytecode(JZ_STATE, jz_bytecode* this);
+void jz_finalize_bytecode(JZ_STATE, jz_bytecode* this);
 
 #endif
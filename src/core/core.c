@@ -1,6 +1,8 @@
 #include "core/core.h"
 #include "core/global.h"
+#include "core/gc.h"
 
 void jz_init_core(JZ_STATE) {
   jz_init_global(jz);
+  jz_init_gc(jz);
 }
@@ -0,0 +1,94 @@
+#include "core/gc.h"
+#include "state.h"
+#include "function.h"
+#include "object.h"
+
+#include <string.h>
+#include <stdio.h>
+
+#define PUT_NUM(jz, obj, name, num) \
+  jz_obj_put2(jz, obj, name, jz_wrap_num(jz, (double)(num)))
+
+/* Times are in milliseconds. */
+static jz_val stats(JZ_STATE, jz_args* args) {
+  jz_gc_stats stats;
+  jz_obj* obj;
+  jz_obj* objects;
+  int i;
+
+  /* Get the stats before allocating anything. */
+  jz_gc_get_stats(jz, &stats);
+  obj = jz_obj_new(jz);
+  objects = jz_obj_new(jz);
+
+  PUT_NUM(jz, obj, "allocated", stats.allocated);
+  PUT_NUM(jz, obj, "threshold", stats.threshold);
+  PUT_NUM(jz, obj, "heapSize", stats.heap_size);
+  PUT_NUM(jz, obj, "atomCapacity", stats.atom_capacity);
+  PUT_NUM(jz, obj, "cycles", stats.cycles);
+  PUT_NUM(jz, obj, "minors", stats.minors);
+  PUT_NUM(jz, obj, "freed", stats.freed);
+  PUT_NUM(jz, obj, "lazyFreed", stats.lazy_freed);
+  PUT_NUM(jz, obj, "backgroundFreed", stats.background_freed);
+  PUT_NUM(jz, obj, "minorFreed", stats.minor_freed);
+  PUT_NUM(jz, obj, "promoted", stats.promoted);
+  PUT_NUM(jz, obj, "markTime", stats.mark_time * 1000);
+  PUT_NUM(jz, obj, "sweepTime", stats.sweep_time * 1000);
+  PUT_NUM(jz, obj, "minorTime", stats.minor_time * 1000);
+  PUT_NUM(jz, obj, "lastMarkTime", stats.last_mark_time * 1000);
+  PUT_NUM(jz, obj, "lastSweepTime", stats.last_sweep_time * 1000);
+  PUT_NUM(jz, obj, "lastFreed", stats.last_freed);
+
+  for (i = 0; i < jz_t_free; i++) {
+    jz_str* name = jz_str_atom_from_chars(jz, jz_gc_type_names[i],
+                                          strlen(jz_gc_type_names[i]));
+    jz_obj_put(jz, objects, name, jz_wrap_num(jz, (double)stats.objects[i]));
+  }
+  jz_obj_put2(jz, obj, "objects", objects);
+
+  return obj;
+}
+
+/* Finishes any collection in progress, then does a whole one. */
+static jz_val collect(JZ_STATE, jz_args* args) {
+  jz_gc_cycle(jz);
+  return JZ_UNDEFINED;
+}
+
+/* Writes a heap snapshot to the named file; see jz_gc_snapshot.
+   Returns false if the file couldn't be opened. */
+static jz_val snapshot(JZ_STATE, jz_args* args, jz_val arg) {
+  char* filename = jz_str_to_chars(jz, jz_to_str(jz, arg));
+  FILE* file = fopen(filename, "w");
+
+  free(filename);
+  if (file == NULL) return JZ_FALSE;
+
+  jz_gc_snapshot(jz, file);
+  fclose(file);
+
+  return JZ_TRUE;
+}
+
+/* Turns lazy sweeping on or off; see jz_gc_set_lazy_sweep. */
+static jz_val set_lazy_sweep(JZ_STATE, jz_args* args, jz_val arg) {
+  jz_gc_set_lazy_sweep(jz, jz_to_bool(jz, arg));
+  return JZ_UNDEFINED;
+}
+
+/* Turns background sweeping on or off; see jz_gc_set_background_sweep. */
+static jz_val set_background_sweep(JZ_STATE, jz_args* args, jz_val arg) {
+  jz_gc_set_background_sweep(jz, jz_to_bool(jz, arg));
+  return JZ_UNDEFINED;
+}
+
+void jz_init_gc(JZ_STATE) {
+  jz_obj* obj = jz_obj_new(jz);
+
+  jz_obj_put2(jz, jz->global_obj, "gc", obj);
+  jz_def(jz, obj, "stats", stats, 0);
+  jz_def(jz, obj, "collect", collect, 0);
+  jz_def(jz, obj, "snapshot", snapshot, 1);
+  jz_def(jz, obj, "setLazySweep", set_lazy_sweep, 1);
+  jz_def(jz, obj, "setBackgroundSweep", set_background_sweep, 1);
+}
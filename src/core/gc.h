@@ -0,0 +1,10 @@
+#ifndef JZ_CORE_GC_H
+#define JZ_CORE_GC_H
+
+#include "jazz.h"
+
+/* Defines the global gc object,
+   which lets scripts look at and drive the collector. */
+void jz_init_gc(JZ_STATE);
+
+#endif
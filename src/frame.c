@@ -1,5 +1,6 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "frame.h"
 #include "state.h"
@@ -7,7 +8,7 @@
 #include "object.h"
 
 static void init_locals(JZ_STATE, jz_val* locals, jz_val* top);
-static void copy_closure_locals(JZ_STATE, const jz_bytecode* function, jz_frame* frame);
+static void copy_closure_locals(JZ_STATE, jz_frame* frame, jz_val* vars);
 static void copy_closure_vars(JZ_STATE, jz_func_data* func, jz_frame* frame);
 
 jz_frame* jz_frame_new_from_func(JZ_STATE, jz_obj* function) {
@@ -15,7 +16,6 @@ jz_frame* jz_frame_new_from_func(JZ_STATE, jz_obj* function) {
   jz_frame* frame = jz_frame_new(jz, data->code);
 
   frame->function = function;
-  frame->closure_locals->scope = data->scope;
   copy_closure_vars(jz, JZ_FUNC_DATA(function), frame);
 
   return frame;
@@ -24,12 +24,13 @@ jz_frame* jz_frame_new_from_func(JZ_STATE, jz_obj* function) {
 jz_frame* jz_frame_new(JZ_STATE, jz_bytecode* function) {
   /* Use calloc to ensure the frame is initially zeroed. */
   jz_frame* frame;
-  size_t extra_size = function->locals_length * sizeof(jz_val) +
-    function->closure_vars_length * sizeof(jz_val*) - 1;
+  size_t extra_size =
+    (function->locals_length + function->closure_locals_length) *
+    sizeof(jz_val) + function->closure_vars_length * sizeof(jz_val*) - 1;
 
   frame = (jz_frame*)jz->stack;
   jz->stack += sizeof(jz_frame) + sizeof(jz_val) * extra_size;
-  jz_check_overflow(jz, NULL);
+  jz_check_overflow(jz);
   memset(frame, 0, sizeof(jz_frame) + extra_size);
 
   frame->mark = !jz->gc.black_bit;
@@ -39,18 +40,10 @@ jz_frame* jz_frame_new(JZ_STATE, jz_bytecode* function) {
   frame->upper = jz->current_frame;
   jz->current_frame = frame;
 
-  frame->closure_locals = (jz_closure_locals*)
-    jz_gc_dyn_malloc(jz, jz_t_closure_locals, sizeof(jz_closure_locals),
-                     sizeof(jz_val), function->closure_locals_length);
-  if (jz_gc_write_barrier_active(jz))
-    jz_gc_mark_gray(jz, &frame->closure_locals->gc);
-
-  frame->closure_locals->scope = NULL;
-  frame->closure_locals->length = function->closure_locals_length;
-  copy_closure_locals(jz, function, frame);
+  frame->closure_locals = NULL;
+  copy_closure_locals(jz, frame, JZ_FRAME_UNBOXED(frame));
 
   init_locals(jz, JZ_FRAME_LOCALS(frame), JZ_FRAME_STACK(frame));
-  init_locals(jz, frame->closure_locals->vars, frame->closure_locals->vars + frame->closure_locals->length);
 
   /* Run a write barrier on the frame
      to make sure locals for newly-created frames
@@ -67,8 +60,28 @@ void init_locals(JZ_STATE, jz_val* locals, jz_val* top) {
     *locals = JZ_UNDEFINED;
 }
 
-void copy_closure_locals(JZ_STATE, const jz_bytecode* function, jz_frame* frame) {
-  jz_val* closure_locals = frame->closure_locals->vars;
+void jz_frame_box_locals(JZ_STATE, jz_frame* frame) {
+  size_t length = frame->bytecode->closure_locals_length;
+  jz_closure_locals* box = (jz_closure_locals*)
+    jz_gc_dyn_malloc(jz, jz_t_closure_locals, sizeof(jz_closure_locals),
+                     sizeof(jz_val), length);
+
+  if (jz_gc_write_barrier_active(jz))
+    jz_gc_mark_gray(jz, &box->gc);
+
+  box->scope = frame->function == NULL ? NULL :
+    JZ_FUNC_DATA(frame->function)->scope;
+  box->length = length;
+  memcpy(box->vars, JZ_FRAME_UNBOXED(frame), length * sizeof(jz_val));
+
+  frame->closure_locals = box;
+  copy_closure_locals(jz, frame, box->vars);
+}
+
+/* Points the frame at 'vars' for the closure variables it declares. */
+void copy_closure_locals(JZ_STATE, jz_frame* frame, jz_val* vars) {
+  const jz_bytecode* function = frame->bytecode;
+  jz_val* closure_locals = vars;
   jz_val** closure_vars = JZ_FRAME_CLOSURE_VARS(frame) +
     function->closure_vars_length - function->closure_locals_length;
   jz_val** top = JZ_FRAME_CLOSURE_VARS(frame) + function->closure_vars_length;
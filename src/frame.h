@@ -19,14 +19,21 @@ struct jz_frame {
   jz_bytecode* bytecode;
   jz_frame* upper;
   jz_closure_locals* closure_locals;
-  /* This points to the stack variable in jz_vm_run.
+  /* This points to the stack variable in jz_vm_run_frame,
+     or to 'stack' below while this frame is waiting on a call.
      It allows the garbage collector to determine
      where the stack ends. */
   jz_val** stack_top;
+  /* Where this frame left off when it called a script function,
+     which jz_vm_run_frame runs without returning to C. */
+  jz_opcode* code;
+  jz_val* stack;
   /* This contains various data used by the frame.
      From top (index 0) to bottom:
      * Pointers to closure variables (jz_val*)
      * Local variables (jz_val)
+     * Closure variables declared in this frame,
+       until they're boxed (jz_val)
      * The stack (jz_val) */
   char data[1];
 };
@@ -36,10 +43,19 @@ jz_frame* jz_frame_new_from_func(JZ_STATE, jz_obj* function);
 jz_frame* jz_frame_new(JZ_STATE, jz_bytecode* function);
 void jz_frame_free_current(JZ_STATE);
 
+/* Variables that closures capture start out in the frame,
+   like other locals,
+   and closure_locals is NULL.
+   Once a closure is made that might refer to them,
+   they're moved into a newly-allocated closure_locals object,
+   so that they can outlive the frame.
+   Frames that never make a closure never allocate one. */
+void jz_frame_box_locals(JZ_STATE, jz_frame* frame);
+
 #define JZ_FRAME_STACK(frame)                                           \
-  ((jz_val*)((frame)->data +                                            \
-             (frame)->bytecode->closure_vars_length * sizeof(jz_val*) + \
-             (frame)->bytecode->locals_length * sizeof(jz_val)))
+  (JZ_FRAME_UNBOXED(frame) + (frame)->bytecode->closure_locals_length)
+#define JZ_FRAME_UNBOXED(frame)                                         \
+  (JZ_FRAME_LOCALS(frame) + (frame)->bytecode->locals_length)
 #define JZ_FRAME_LOCALS(frame)                                          \
   ((jz_val*)((frame)->data +                                            \
                  (frame)->bytecode->closure_vars_length * sizeof(jz_val*)))
@@ -9,82 +9,81 @@
 
 #define ARG(i) ((i) < argc ? argv[i] : JZ_UNDEFINED)
 
-static jz_obj* create_func(JZ_STATE, int arity);
+static jz_obj* create_func(JZ_STATE, int arity, size_t captures_length);
 static jz_val call_jazz_func(JZ_STATE, jz_args* args, int argc, const jz_val* argv);
 static void finalizer(JZ_STATE, jz_obj* obj);
 static void marker(JZ_STATE, jz_obj* obj);
 
 jz_val jz_call_arr(JZ_STATE, jz_obj* func, int argc, const jz_val* argv) {
-  jz_args* args;
-  jz_val ret;
+  jz_func_data* data;
+  jz_args args;
 
   if (func->call == NULL) {
     fprintf(stderr, "TypeError: %s is not a function.\n", jz_str_to_chars(jz, jz_to_str(jz, func)));
     exit(1);
   }
 
-  args = malloc(sizeof(jz_args));
-  args->callee = func;
-  args->length = argc;
-  args->argv = argv;
+  /* Script functions take their arguments straight off the Jazz stack
+     and have no use for a jz_args. */
+  data = JZ_FUNC_DATA(func);
+  if (data->code != NULL)
+    return jz_vm_run_frame(jz, jz_func_new_frame(jz, func, argc, argv));
+
+  /* Native functions can't hold onto this past the call. */
+  args.callee = func;
+  args.length = argc;
+  args.argv = argv;
 
-  switch (((jz_func_data*)func->data)->arity) {
+  switch (data->arity) {
   case JZ_ARITY_VAR:
-    ret = func->call(jz, args, argc, argv);
-    break;
+    return func->call(jz, &args, argc, argv);
   case 0:
-    ret = func->call(jz, args);
-    break;
+    return func->call(jz, &args);
 
     /* This is hideous, but I don't think there's a better way to do it. */
   case 1:
-    ret = func->call(jz, args, ARG(0));
-    break;
+    return func->call(jz, &args, ARG(0));
   case 2:
-    ret = func->call(jz, args, ARG(0), ARG(1));
-    break;
+    return func->call(jz, &args, ARG(0), ARG(1));
   case 3:
-    ret = func->call(jz, args, ARG(0), ARG(1), ARG(2));
-    break;
+    return func->call(jz, &args, ARG(0), ARG(1), ARG(2));
   case 4:
-    ret = func->call(jz, args, ARG(0), ARG(1), ARG(2),
-                     ARG(4));
-    break;
+    return func->call(jz, &args, ARG(0), ARG(1), ARG(2), ARG(3));
   case 5:
-    ret = func->call(jz, args, ARG(0), ARG(1), ARG(2),
-                     ARG(4), ARG(5));
-    break;
+    return func->call(jz, &args, ARG(0), ARG(1), ARG(2), ARG(3),
+                      ARG(4));
   case 6:
-    ret = func->call(jz, args, ARG(0), ARG(1), ARG(2),
-                     ARG(4), ARG(5), ARG(6));
-    break;
+    return func->call(jz, &args, ARG(0), ARG(1), ARG(2), ARG(3),
+                      ARG(4), ARG(5));
   case 7:
-    ret = func->call(jz, args, ARG(0), ARG(1), ARG(2),
-                     ARG(4), ARG(5), ARG(6), ARG(7));
-    break;
+    return func->call(jz, &args, ARG(0), ARG(1), ARG(2), ARG(3),
+                      ARG(4), ARG(5), ARG(6));
   case 8:
-    ret = func->call(jz, args, ARG(0), ARG(1), ARG(2),
-                     ARG(4), ARG(5), ARG(6), ARG(7), ARG(8));
-    break;
+    return func->call(jz, &args, ARG(0), ARG(1), ARG(2), ARG(3),
+                      ARG(4), ARG(5), ARG(6), ARG(7));
+  default:
+    fprintf(stderr, "Invalid arity %d\n", data->arity);
+    exit(1);
   }
-
-  free(args);
-  return ret;
 }
 
-jz_obj* create_func(JZ_STATE, int arity) {
+jz_obj* create_func(JZ_STATE, int arity, size_t captures_length) {
   jz_obj* obj = jz_inst(jz, "Function");
   jz_obj* proto = jz_obj_new(jz);
 
-  /* jz_func_data includes room for one byte of arity calculation.
-     This cancels out the rounding-down of integer division. */
-  jz_func_data* data = malloc(sizeof(jz_func_data));
+  /* The captures are allocated along with the rest of the data.
+     jz_func_data already has room for one. */
+  jz_func_data* data = malloc(sizeof(jz_func_data) +
+                              sizeof(jz_val) * captures_length);
+  size_t i;
 
   obj->data = data;
   data->code = NULL;
   data->arity = 0;
   data->scope = NULL;
   data->closure_vars = NULL;
+  for (i = 0; i < captures_length; i++)
+    data->captures[i] = JZ_UNDEFINED;
 
   jz_obj_put2(jz, obj, "length", jz_wrap_num(jz, arity));
   jz_obj_put2(jz, proto, "constructor", obj);
@@ -94,7 +93,7 @@ jz_obj* create_func(JZ_STATE, int arity) {
 }
 
 jz_obj* jz_func_new(JZ_STATE, jz_bytecode* code) {
-  jz_obj* obj = create_func(jz, code->arity);
+  jz_obj* obj = create_func(jz, code->arity, code->captures_length);
   jz_func_data* data = JZ_FUNC_DATA(obj);
 
   obj->call = call_jazz_func;
@@ -106,23 +105,65 @@ jz_obj* jz_func_new(JZ_STATE, jz_bytecode* code) {
 
 void jz_func_set_scope(JZ_STATE, jz_obj* this, jz_frame* scope) {
   jz_func_data* data = JZ_FUNC_DATA(this);
+  jz_capture* capture = data->code->captures;
+  jz_capture* top = capture + data->code->captures_length;
+  jz_val* captures = data->captures;
+
+  for (; capture < top; capture++, captures++) {
+    *captures = capture->from_capture ?
+      JZ_FUNC_DATA(scope->function)->captures[capture->index] :
+      JZ_FRAME_LOCALS(scope)[capture->index];
+  }
+
+  if (scope->closure_locals == NULL &&
+      scope->bytecode->closure_locals_length > 0)
+    jz_frame_box_locals(jz, scope);
+
+  /* A frame that declares no closure variables has nothing to box,
+     so the new function shares its scope with the frame's function. */
+  if (scope->closure_locals != NULL)
+    data->scope = scope->closure_locals;
+  else if (scope->function != NULL)
+    data->scope = JZ_FUNC_DATA(scope->function)->scope;
+  else
+    data->scope = NULL;
+
+  if (scope->bytecode->closure_vars_length == 0)
+    return;
 
-  data->scope = scope->closure_locals;
   data->closure_vars = calloc(sizeof(jz_val*), scope->bytecode->closure_vars_length);
   memcpy(data->closure_vars, JZ_FRAME_CLOSURE_VARS(scope),
          scope->bytecode->closure_vars_length * sizeof(jz_val*));
 }
 
+/* This is only here for code that calls obj->call directly;
+   jz_call_arr and the VM use jz_func_new_frame. */
 jz_val call_jazz_func(JZ_STATE, jz_args* args, int argc, const jz_val* argv) {
-  jz_frame* frame = jz_frame_new_from_func(jz, args->callee);
-  jz_byte* param_locs = JZ_FUNC_DATA(args->callee)->code->param_locs;
-  jz_val** closure_vars = JZ_FRAME_CLOSURE_VARS(frame);
+  return jz_vm_run_frame(jz, jz_func_new_frame(jz, args->callee, argc, argv));
+}
+
+/* Copies the arguments from the caller's stack
+   into the new frame's locals and closure variables.
+   Extra arguments are dropped. */
+jz_frame* jz_func_new_frame(JZ_STATE, jz_obj* func,
+                            int argc, const jz_val* argv) {
+  jz_frame* frame = jz_frame_new_from_func(jz, func);
+  jz_bytecode* code = JZ_FUNC_DATA(func)->code;
+  jz_byte* param_locs = code->param_locs;
+  /* Captured parameters are the first of the function's own closure variables,
+     which come after the ones inherited from the enclosing scope. */
+  jz_val** closure_vars = JZ_FRAME_CLOSURE_VARS(frame) +
+    code->closure_vars_length - code->closure_locals_length;
   jz_val* locals = JZ_FRAME_LOCALS(frame);
   int i = 0;
 
+  if (argc > code->arity)
+    argc = code->arity;
+
   for (; i < argc; i++, argv++) {
     if (JZ_BITFIELD_GET(param_locs, i)) {
       **closure_vars = *argv;
+      JZ_GC_WRITE_BARRIER_SLOT(jz, *closure_vars, *argv);
       closure_vars++;
     } else {
       *locals = *argv;
@@ -130,11 +171,11 @@ jz_val call_jazz_func(JZ_STATE, jz_args* args, int argc, const jz_val* argv) {
     }
   }
 
-  return jz_vm_run_frame(jz, frame);
+  return frame;
 }
 
 jz_obj* jz_fn_to_obj(JZ_STATE, jz_fn* fn, int arity) {
-  jz_obj* obj = create_func(jz, arity);
+  jz_obj* obj = create_func(jz, arity, 0);
   jz_func_data* data = JZ_FUNC_DATA(obj);
 
   obj->call = fn;
@@ -170,6 +211,11 @@ void marker(JZ_STATE, jz_obj* obj) {
   if (data->scope)
     jz_gc_mark_gray(jz, &data->scope->gc);
 
-  if (data->code)
+  if (data->code) {
+    size_t i;
+
     jz_gc_mark_gray(jz, &data->code->gc);
+    for (i = 0; i < data->code->captures_length; i++)
+      JZ_GC_MARK_VAL_GRAY(jz, data->captures[i]);
+  }
 }
@@ -53,6 +53,10 @@ typedef struct jz_func_data {
   jz_bytecode* code;
   jz_closure_locals* scope;
   jz_val** closure_vars;
+  /* Copies of the variables in code->captures,
+     filled in by jz_func_set_scope.
+     There are code->captures_length of them. */
+  jz_val captures[1];
 } jz_func_data;
 
 #define JZ_ARITY_VAR -1
@@ -62,6 +66,15 @@ typedef struct jz_func_data {
 
 jz_val jz_call_arr(JZ_STATE, jz_obj* func, int argc, const jz_val* argv);
 
+/* Whether 'func' is compiled from a script rather than native. */
+#define JZ_FUNC_IS_BYTECODE(func) \
+  ((func)->call != NULL && JZ_FUNC_DATA(func)->code != NULL)
+
+/* Pushes a frame for calling the script function 'func'
+   with its arguments filled in, ready to be run. */
+jz_frame* jz_func_new_frame(JZ_STATE, jz_obj* func,
+                            int argc, const jz_val* argv);
+
 jz_obj* jz_func_new(JZ_STATE, jz_bytecode* code);
 void jz_func_set_scope(JZ_STATE, jz_obj* this, jz_frame* scope);
 
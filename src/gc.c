@@ -1,18 +1,62 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#if JZ_GC_THREADS > 1
+#include <pthread.h>
+#endif
 
 #include "gc.h"
 #include "state.h"
 #include "string.h"
 #include "object.h"
 #include "prototype.h"
+#include "shape.h"
+#include "ic.h"
+#include "cells.h"
 
 #define MARK_BLACK(obj) \
   (JZ_SET_BIT(JZ_GC_TAG(obj), JZ_GC_FLAG_BIT, jz->gc.black_bit))
 #define MARK_WHITE(obj) \
   (JZ_SET_BIT(JZ_GC_TAG(obj), JZ_GC_FLAG_BIT, !jz->gc.black_bit))
 
+struct jz_gc_page {
+  jz_gc_page* next; /* The next page in the size class. */
+  size_t slot_size;
+  jz_byte* top; /* The end of the slots that have been handed out. */
+  jz_byte* end;
+};
+
+struct jz_gc_large {
+  jz_gc_large* next;
+  jz_gc_large* prev;
+  size_t size;
+};
+
+/* A slot on a size class's free list. */
+typedef struct {
+  jz_gc_header gc;
+  jz_gc_header* next;
+} free_slot;
+
+#define ROUND_UP(size) \
+  (((size) + JZ_GC_GRANULE - 1) & ~(size_t)(JZ_GC_GRANULE - 1))
+#define PAGE_SLOTS(page) ((jz_byte*)(page) + ROUND_UP(sizeof(jz_gc_page)))
+#define LARGE_OBJ(large) \
+  ((jz_gc_header*)((jz_byte*)(large) + ROUND_UP(sizeof(jz_gc_large))))
+#define LARGE_HEADER(obj) \
+  ((jz_gc_large*)((jz_byte*)(obj) - ROUND_UP(sizeof(jz_gc_large))))
+#define IS_SMALL(size) ((size) <= JZ_GC_SIZE_CLASSES * JZ_GC_GRANULE)
+
+#define SET_OLD(obj) (JZ_SET_BIT(JZ_GC_TAG(obj), JZ_GC_OLD_BIT, jz_true))
+#define MIN_ARRAY 64
+
+const char* jz_gc_type_names[] = {
+  "str", "num", "enum", "cons", "str_value", "closure_locals",
+  "obj", "proto", "bytecode", "shape"
+};
+
 static void blacken(JZ_STATE, jz_gc_header* obj);
 #define blacken_num(jz, val) /* Numbers have no references. */
 static void blacken_obj(JZ_STATE, jz_obj* obj);
@@ -22,33 +66,324 @@ static void blacken_closure_locals(JZ_STATE, jz_closure_locals* closure_locals);
 static void blacken_proto(JZ_STATE, jz_proto* proto);
 static void blacken_bytecode(JZ_STATE, jz_bytecode* code);
 static void blacken_cons(JZ_STATE, jz_cons* node);
+static void blacken_shape(JZ_STATE, jz_shape* shape);
 #define blacken_enum(jz, val) /* Enums have no references. */
 
+static void push_gray_stack(JZ_STATE, jz_gc_header* obj);
 static jz_gc_header* pop_gray_stack(JZ_STATE);
+static jz_bool grow_gray_stack(JZ_STATE);
+static void drain_gray_stack(JZ_STATE);
+static void rescan_heap(JZ_STATE);
+static void rescan_young(JZ_STATE);
+static void rescan_obj(JZ_STATE, jz_gc_header* obj);
 static void mark_roots(JZ_STATE);
 static void mark_step(JZ_STATE);
+static void start_sweep(JZ_STATE);
 static jz_bool sweep_step(JZ_STATE);
-static void gc_free(JZ_STATE, jz_gc_header* obj);
+static size_t sweep_slots(JZ_STATE, jz_gc_size_class* class, size_t budget);
+static void finalize(JZ_STATE, jz_gc_header* obj);
+
+static jz_gc_header* alloc_small(JZ_STATE, size_t size);
+static jz_gc_header* alloc_large(JZ_STATE, size_t size);
+static jz_gc_page* new_page(JZ_STATE, jz_gc_size_class* class, size_t slot_size);
+static void release_small(JZ_STATE, jz_gc_header* obj, size_t size);
+static void release_large(JZ_STATE, jz_gc_large* large);
+static void* grow_array(void* array, size_t* capacity, size_t size);
+
+static void add_young(JZ_STATE, jz_gc_header* obj, size_t size);
+static void promote_nursery(JZ_STATE);
+static void forget_remembered(JZ_STATE);
 
 static void finish_cycle(JZ_STATE);
 
+static void snapshot_obj(JZ_STATE, jz_gc_header* obj, size_t size);
+
+static jz_bool timed_steps(JZ_STATE, size_t steps);
+static void charge_time(JZ_STATE, jz_byte phase, double seconds);
+static double now(void);
+
+#if JZ_GC_THREADS > 1
+/* A thread that's helping with parallel marking.
+   Each has its own gray stack, which the others can steal from. */
+struct jz_gc_worker {
+  jz_state jz; /* A copy of the real state with its own gray stack. */
+  pthread_t thread;
+  pthread_mutex_t lock; /* Protects jz.gc.gray_stack. */
+  jz_gc_worker* all;
+  /* The number of workers that have work or are trying to steal some.
+     Marking is done once this is zero. */
+  volatile int* busy;
+};
+
+static void parallel_mark(JZ_STATE);
+static void* run_worker(void* worker);
+static jz_gc_header* find_work(jz_gc_worker* self);
+static jz_gc_header* pop_locked(jz_gc_worker* worker);
+static jz_bool worker_mark_gray(JZ_STATE, jz_gc_header* obj);
+
+/* A dead object found by the background sweeper
+   that has to be finalized on the mutator's thread. */
+typedef struct {
+  jz_gc_header* obj;
+  size_t size;
+} dead_obj;
+
+/* A thread that sweeps the size classes
+   while the mutator gets on with things.
+   See jz_gc_set_background_sweep.
+
+   The sweeper rebuilds each class's free list from scratch,
+   so the allocator starts out with none
+   and carves new pages until the sweeper hands some slots over.
+   Once a page has been handed over, the sweeper never looks at it again,
+   so the two never touch the same slots. */
+struct jz_gc_sweeper {
+  jz_state* jz;
+  pthread_t thread;
+  jz_bool joined;
+
+  /* Where each class's sweep starts.
+     Pages added since then are the allocator's. */
+  jz_gc_page* pages[JZ_GC_SIZE_CLASSES];
+
+  pthread_mutex_t lock; /* Protects everything below. */
+  jz_gc_header* swept[JZ_GC_SIZE_CLASSES];
+  jz_gc_header* swept_tail[JZ_GC_SIZE_CLASSES];
+  dead_obj* dead;
+  size_t dead_length;
+  size_t dead_capacity;
+  size_t freed; /* Not yet subtracted from jz->gc.allocated. */
+  jz_bool done;
+};
+
+static void start_sweeper(JZ_STATE);
+static void* run_sweeper(void* sweeper);
+static void sweep_page(jz_gc_sweeper* self, int class_index, jz_gc_page* page);
+static void take_swept(JZ_STATE, jz_gc_size_class* class);
+static size_t finalize_dead(JZ_STATE, size_t budget);
+static void wait_for_sweeper(JZ_STATE);
+static jz_bool finish_sweeper(JZ_STATE);
+#else
+#define wait_for_sweeper(jz)
+#endif
+
 jz_gc_header* jz_gc_malloc(JZ_STATE, jz_type type, size_t size) {
   jz_gc_header* to_ret;
 
   assert(size >= sizeof(jz_gc_header));
-  to_ret = calloc(size, 1); /* calloc zeroes memory. */
+  if (IS_SMALL(size)) {
+    size = ROUND_UP(size);
+    to_ret = alloc_small(jz, size);
+  } else to_ret = alloc_large(jz, size);
+
   JZ_GC_TAG(to_ret) = 0;
   JZ_GC_SET_TYPE(to_ret, type);
-  MARK_WHITE(to_ret);
 
-  to_ret->next = jz->gc.all_objs;
-  jz->gc.all_objs = to_ret;
+  /* Objects allocated while marking are black,
+     so that they survive the cycle
+     even if nothing has been made to refer to them yet. */
+  if (jz_gc_write_barrier_active(jz))
+    MARK_BLACK(to_ret);
+  else MARK_WHITE(to_ret);
+
+  /* Everything is old during a major collection;
+     see promote_nursery. */
+  if (jz_gc_paused(jz)) {
+    add_young(jz, to_ret, size);
+
+    if (jz_gc_within_threshold(jz) && !jz_gc_nursery_full(jz))
+      return to_ret;
+  } else SET_OLD(to_ret);
+
+  jz->gc.debt += size;
+  return to_ret;
+}
 
+/* Returns a zeroed slot of 'size' bytes,
+   which must be a multiple of JZ_GC_GRANULE. */
+jz_gc_header* alloc_small(JZ_STATE, size_t size) {
+  jz_gc_size_class* class = jz->gc.classes + size / JZ_GC_GRANULE - 1;
+  jz_gc_header* to_ret;
+
+  /* While sweeping, reuse this class's garbage
+     before carving out any new slots. */
+  if (class->free_slots == NULL && class->sweep_page != NULL) {
+    size_t freed = jz->gc.stats.last_freed;
+
+    while (class->free_slots == NULL && class->sweep_page != NULL)
+      sweep_slots(jz, class, JZ_GC_PAGE_SIZE / size);
+    if (jz->gc.state == jz_gcs_lazy_sweeping)
+      jz->gc.stats.lazy_freed += jz->gc.stats.last_freed - freed;
+  }
+#if JZ_GC_THREADS > 1
+  if (class->free_slots == NULL && jz->gc.sweeper != NULL)
+    take_swept(jz, class);
+#endif
+
+  to_ret = class->free_slots;
+  if (to_ret != NULL)
+    class->free_slots = ((free_slot*)to_ret)->next;
+  else {
+    jz_gc_page* page = class->page;
+
+    if (page == NULL || page->top == page->end)
+      page = class->page = new_page(jz, class, size);
+
+    to_ret = (jz_gc_header*)page->top;
+    page->top += size;
+  }
+
+  memset(to_ret, 0, size);
   jz->gc.allocated += size;
 
   return to_ret;
 }
 
+jz_gc_header* alloc_large(JZ_STATE, size_t size) {
+  jz_gc_large* large = calloc(ROUND_UP(sizeof(jz_gc_large)) + size, 1);
+
+  large->size = size;
+  large->prev = NULL;
+  large->next = jz->gc.large_objs;
+  if (large->next != NULL)
+    large->next->prev = large;
+  jz->gc.large_objs = large;
+  jz->gc.allocated += size;
+
+  return LARGE_OBJ(large);
+}
+
+jz_gc_page* new_page(JZ_STATE, jz_gc_size_class* class, size_t slot_size) {
+  jz_gc_page* page = malloc(JZ_GC_PAGE_SIZE);
+  size_t slots = (JZ_GC_PAGE_SIZE - (PAGE_SLOTS(page) - (jz_byte*)page)) / slot_size;
+
+  page->slot_size = slot_size;
+  page->top = PAGE_SLOTS(page);
+  page->end = page->top + slots * slot_size;
+  page->next = class->pages;
+  class->pages = page;
+
+  return page;
+}
+
+void release_small(JZ_STATE, jz_gc_header* obj, size_t size) {
+  jz_gc_size_class* class = jz->gc.classes + size / JZ_GC_GRANULE - 1;
+
+  JZ_GC_TAG(obj) = 0;
+  JZ_GC_SET_TYPE(obj, jz_t_free);
+  ((free_slot*)obj)->next = class->free_slots;
+  class->free_slots = obj;
+  jz->gc.allocated -= size;
+
+  if (jz->gc.state == jz_gcs_minor)
+    jz->gc.stats.minor_freed += size;
+  else jz->gc.stats.last_freed += size;
+}
+
+void release_large(JZ_STATE, jz_gc_large* large) {
+  if (large->prev != NULL)
+    large->prev->next = large->next;
+  else jz->gc.large_objs = large->next;
+
+  if (large->next != NULL)
+    large->next->prev = large->prev;
+
+  jz->gc.allocated -= large->size;
+  if (jz->gc.state == jz_gcs_minor)
+    jz->gc.stats.minor_freed += large->size;
+  else jz->gc.stats.last_freed += large->size;
+  free(large);
+}
+
+/* Doubles the capacity of a malloc'd array
+   whose elements are 'size' bytes. */
+void* grow_array(void* array, size_t* capacity, size_t size) {
+  *capacity = *capacity == 0 ? MIN_ARRAY : *capacity * 2;
+  array = realloc(array, *capacity * size);
+
+  if (array == NULL) {
+    fprintf(stderr, "Out of memory.\n");
+    exit(1);
+  }
+  return array;
+}
+
+void add_young(JZ_STATE, jz_gc_header* obj, size_t size) {
+  jz_gc_young* young;
+
+  if (jz->gc.nursery.length == jz->gc.nursery.capacity)
+    jz->gc.nursery.objs = grow_array(jz->gc.nursery.objs,
+                                     &jz->gc.nursery.capacity,
+                                     sizeof(jz_gc_young));
+
+  young = jz->gc.nursery.objs + jz->gc.nursery.length++;
+  young->obj = obj;
+  young->size = size;
+  jz->gc.nursery.bytes += size;
+}
+
+jz_bool jz_gc_remember(JZ_STATE, jz_gc_header* obj) {
+  if (jz->gc.remembered.length == jz->gc.remembered.capacity)
+    jz->gc.remembered.objs = grow_array(jz->gc.remembered.objs,
+                                        &jz->gc.remembered.capacity,
+                                        sizeof(jz_gc_header*));
+
+  JZ_SET_BIT(JZ_GC_TAG(obj), JZ_GC_OLD_BIT, jz_false);
+  jz->gc.remembered.objs[jz->gc.remembered.length++] = obj;
+  return jz_true;
+}
+
+jz_bool jz_gc_remember_slot(JZ_STATE, jz_val* slot) {
+  size_t length = jz->gc.remembered_slots.length;
+
+  /* Closure variables that haven't been boxed are still in their frame
+     (see jz_frame_box_locals), so they're roots already,
+     and they'll be gone once the frame returns. */
+  if ((jz_byte*)slot >= jz->stack_bottom && (jz_byte*)slot < jz->stack)
+    return jz_false;
+
+  /* Loops tend to store to the same variable over and over. */
+  if (length > 0 && jz->gc.remembered_slots.slots[length - 1] == slot)
+    return jz_false;
+
+  if (length == jz->gc.remembered_slots.capacity)
+    jz->gc.remembered_slots.slots =
+      grow_array(jz->gc.remembered_slots.slots,
+                 &jz->gc.remembered_slots.capacity, sizeof(jz_val*));
+
+  jz->gc.remembered_slots.slots[jz->gc.remembered_slots.length++] = slot;
+  return jz_true;
+}
+
+/* Makes every young object old and empties the nursery.
+   This happens when a major collection starts,
+   so there are no young objects until it's finished.
+   That means a minor collection never has to deal with
+   objects that the major collection is halfway through with. */
+void promote_nursery(JZ_STATE) {
+  jz_gc_young* young = jz->gc.nursery.objs;
+  jz_gc_young* top = young + jz->gc.nursery.length;
+
+  for (; young < top; young++)
+    SET_OLD(young->obj);
+
+  jz->gc.nursery.length = 0;
+  jz->gc.nursery.bytes = 0;
+}
+
+/* Empties the remembered set,
+   restoring the old bits of the objects in it. */
+void forget_remembered(JZ_STATE) {
+  jz_gc_header** obj = jz->gc.remembered.objs;
+  jz_gc_header** top = obj + jz->gc.remembered.length;
+
+  for (; obj < top; obj++)
+    SET_OLD(*obj);
+
+  jz->gc.remembered.length = 0;
+  jz->gc.remembered_slots.length = 0;
+}
+
 jz_gc_header* jz_gc_dyn_malloc(JZ_STATE, jz_type type, size_t struct_size,
                             size_t extra_size, size_t number) {
   assert(struct_size - extra_size >= sizeof(jz_gc_header));
@@ -56,24 +391,36 @@ jz_gc_header* jz_gc_dyn_malloc(JZ_STATE, jz_type type, size_t struct_size,
 }
 
 jz_bool jz_gc_mark_gray(JZ_STATE, jz_gc_header* obj) {
-  jz_gc_node* node;
-
-  assert(jz_gc_write_barrier_active(jz));
+  assert(jz_gc_write_barrier_active(jz) || jz->gc.state == jz_gcs_minor ||
+         jz->gc.state == jz_gcs_snapshot);
 
   if (obj == NULL)
     return jz_false;
 
+  /* Rather than marking, write down the reference. */
+  if (jz->gc.state == jz_gcs_snapshot) {
+    fprintf(jz->gc.snapshot, " %lx", (unsigned long)(jz_ival)obj);
+    return jz_false;
+  }
+
+#if JZ_GC_THREADS > 1
+  if (jz->gc.worker != NULL)
+    return worker_mark_gray(jz, obj);
+#endif
+
   /* If the object is already black,
      we don't need to do anything about it. */
   if (jz_gc_is_black(jz, obj))
     return jz_false;
 
-  node = malloc(sizeof(jz_gc_node));
+  /* Minor collections don't trace through old objects.
+     Any young objects they refer to are found
+     through the remembered set instead. */
+  if (jz->gc.state == jz_gcs_minor && jz_gc_is_old(obj))
+    return jz_false;
 
-  node->next = jz->gc.gray_stack;
-  node->obj = obj;
-  jz->gc.gray_stack = node;
   MARK_BLACK(obj);
+  push_gray_stack(jz, obj);
 
   return jz_true;
 }
@@ -81,26 +428,313 @@ jz_bool jz_gc_mark_gray(JZ_STATE, jz_gc_header* obj) {
 void jz_gc_cycle(JZ_STATE) {
   /* Make sure we finish up an existing cycle
      before we start a new one. */
-  if (!jz_gc_paused(jz))
-    while (!jz_gc_step(jz));
-  while (!jz_gc_step(jz));
+  if (jz->gc.state != jz_gcs_waiting)
+    while (!timed_steps(jz, JZ_GC_SWEEP_BUDGET))
+      wait_for_sweeper(jz);
+
+#if JZ_GC_THREADS > 1
+  if (jz->gc.allocated >= JZ_GC_PARALLEL_HEAP) {
+    double start;
+
+    timed_steps(jz, 1); /* Marks the roots. */
+    start = now();
+    parallel_mark(jz);
+    charge_time(jz, jz_gcs_marking, now() - start);
+  }
+#endif
+
+  while (!timed_steps(jz, JZ_GC_SWEEP_BUDGET))
+    wait_for_sweeper(jz);
+}
+
+#if JZ_GC_THREADS > 1
+/* Marks everything reachable from the gray stack using JZ_GC_THREADS threads,
+   this one included.
+   The mutator doesn't run in the meantime.
+
+   The gray objects are dealt out to the workers,
+   each of which blackens objects from its own stack
+   and steals from the others' when that runs out.
+   Mark bits are set atomically,
+   so each object is only pushed by the worker that marked it. */
+void parallel_mark(JZ_STATE) {
+  jz_gc_worker workers[JZ_GC_THREADS];
+  volatile int busy = JZ_GC_THREADS;
+  jz_gc_header* obj;
+  int i;
+
+  for (i = 0; i < JZ_GC_THREADS; i++) {
+    jz_gc_worker* worker = workers + i;
+
+    worker->jz = *jz;
+    worker->jz.gc.worker = worker;
+    worker->jz.gc.gray_stack.objs =
+      malloc(JZ_GC_GRAY_STACK_MIN * sizeof(jz_gc_header*));
+    worker->jz.gc.gray_stack.length = 0;
+    worker->jz.gc.gray_stack.capacity = JZ_GC_GRAY_STACK_MIN;
+    worker->jz.gc.gray_stack.overflowed = jz_false;
+    pthread_mutex_init(&worker->lock, NULL);
+    worker->all = workers;
+    worker->busy = &busy;
+  }
+
+  for (i = 0; (obj = pop_gray_stack(jz)) != NULL; i++)
+    push_gray_stack(&workers[i % JZ_GC_THREADS].jz, obj);
+
+  for (i = 1; i < JZ_GC_THREADS; i++) {
+    if (pthread_create(&workers[i].thread, NULL, run_worker, workers + i)) {
+      fprintf(stderr, "Couldn't create a GC thread.\n");
+      exit(1);
+    }
+  }
+  run_worker(workers);
+
+  for (i = 1; i < JZ_GC_THREADS; i++)
+    pthread_join(workers[i].thread, NULL);
+
+  /* The locks can't go until every worker's done,
+     since an idle worker may still be trying to steal. */
+  for (i = 0; i < JZ_GC_THREADS; i++) {
+    /* Any overflow is dealt with by mark_step's usual rescan. */
+    if (workers[i].jz.gc.gray_stack.overflowed)
+      jz->gc.gray_stack.overflowed = jz_true;
+
+    free(workers[i].jz.gc.gray_stack.objs);
+    pthread_mutex_destroy(&workers[i].lock);
+  }
 }
 
-jz_bool jz_gc_steps(JZ_STATE) {
-  jz_byte i;
-  jz_byte steps = jz->gc.speed;
+void* run_worker(void* worker) {
+  jz_gc_worker* self = worker;
+  jz_gc_header* obj;
+
+  while ((obj = find_work(self)) != NULL)
+    blacken(&self->jz, obj);
+  return NULL;
+}
+
+/* Returns the next object for 'self' to blacken,
+   or NULL once every worker is out of work. */
+jz_gc_header* find_work(jz_gc_worker* self) {
+  jz_gc_header* obj = pop_locked(self);
+  int i;
+
+  if (obj != NULL)
+    return obj;
 
-  for (i = 0; i < steps; i++) {
-    if (jz_gc_step(jz))
-      /* We don't want to run over into a new collection cycle. */
-      return jz_true;
+  /* A worker is only idle once its own stack is empty,
+     and nothing can be pushed onto it until it's busy again.
+     So once every worker is idle, there's nothing left to do. */
+  __sync_sub_and_fetch(self->busy, 1);
+
+  while (__sync_add_and_fetch(self->busy, 0) > 0) {
+    for (i = 0; i < JZ_GC_THREADS; i++) {
+      jz_gc_worker* victim = self->all + i;
+
+      if (victim == self)
+        continue;
+
+      /* This has to count as busy before it takes anything,
+         so that the others don't give up while it's holding an object. */
+      __sync_add_and_fetch(self->busy, 1);
+      obj = pop_locked(victim);
+      if (obj != NULL)
+        return obj;
+      __sync_sub_and_fetch(self->busy, 1);
+    }
   }
+
+  return NULL;
+}
+
+jz_gc_header* pop_locked(jz_gc_worker* worker) {
+  jz_gc_header* obj;
+
+  pthread_mutex_lock(&worker->lock);
+  obj = pop_gray_stack(&worker->jz);
+  pthread_mutex_unlock(&worker->lock);
+
+  return obj;
+}
+
+/* jz_gc_mark_gray for a worker's copy of the state. */
+jz_bool worker_mark_gray(JZ_STATE, jz_gc_header* obj) {
+  jz_gc_worker* self = jz->gc.worker;
+  jz_tag mask = JZ_BITMASK(JZ_GC_FLAG_BIT);
+  jz_tag old_tag;
+
+  if (jz_gc_is_black(jz, obj))
+    return jz_false;
+
+  if (jz->gc.black_bit)
+    old_tag = __sync_fetch_and_or(&JZ_GC_TAG(obj), mask);
+  else old_tag = __sync_fetch_and_and(&JZ_GC_TAG(obj), (jz_tag)~mask);
+
+  /* Another worker got there first. */
+  if (JZ_BIT(old_tag, JZ_GC_FLAG_BIT) == jz->gc.black_bit)
+    return jz_false;
+
+  pthread_mutex_lock(&self->lock);
+  push_gray_stack(jz, obj);
+  pthread_mutex_unlock(&self->lock);
+
+  return jz_true;
+}
+#endif
+
+jz_bool jz_gc_minor(JZ_STATE) {
+  jz_gc_young* young;
+  jz_gc_young* young_top;
+  jz_byte state = jz->gc.state;
+  double start = now();
+  double elapsed;
+  size_t freed = jz->gc.stats.minor_freed;
+  size_t promoted = 0;
+  size_t i;
+
+  assert(jz_gc_paused(jz));
+  jz->gc.state = jz_gcs_minor;
+
+  for (i = 0; i < jz->gc.remembered.length; i++)
+    jz_gc_mark_gray(jz, jz->gc.remembered.objs[i]);
+  for (i = 0; i < jz->gc.remembered_slots.length; i++)
+    JZ_GC_MARK_VAL_GRAY(jz, *jz->gc.remembered_slots.slots[i]);
+  mark_roots(jz);
+
+  drain_gray_stack(jz);
+  while (jz->gc.gray_stack.overflowed)
+    rescan_young(jz);
+
+  /* Everything that was reached is black;
+     everything else in the nursery is garbage. */
+  young = jz->gc.nursery.objs;
+  young_top = young + jz->gc.nursery.length;
+  for (; young < young_top; young++) {
+    jz_gc_header* obj = young->obj;
+
+    if (jz_gc_is_black(jz, obj)) {
+      MARK_WHITE(obj);
+      SET_OLD(obj);
+      promoted += young->size;
+      continue;
+    }
+
+    finalize(jz, obj);
+    if (IS_SMALL(young->size))
+      release_small(jz, obj, young->size);
+    else release_large(jz, LARGE_HEADER(obj));
+  }
+  jz->gc.nursery.length = 0;
+  jz->gc.nursery.bytes = 0;
+
+  /* The remembered objects were traced, and so marked black. */
+  for (i = 0; i < jz->gc.remembered.length; i++)
+    MARK_WHITE(jz->gc.remembered.objs[i]);
+  forget_remembered(jz);
+
+  jz->gc.state = state;
+  elapsed = now() - start;
+  jz->gc.stats.minors++;
+  jz->gc.stats.promoted += promoted;
+  jz->gc.stats.minor_time += elapsed;
+
+  if (jz->gc.trace)
+    fprintf(stderr, "gc: minor %lu: %.3f ms, freed %lu bytes, promoted %lu\n",
+            jz->gc.stats.minors, elapsed * 1000,
+            (unsigned long)(jz->gc.stats.minor_freed - freed),
+            (unsigned long)promoted);
+
   return jz_false;
 }
 
+jz_bool jz_gc_pay(JZ_STATE) {
+  size_t steps;
+
+  if (jz_gc_paused(jz) && jz_gc_within_threshold(jz)) {
+    /* The debt was only run up because the nursery is full. */
+    jz->gc.debt = 0;
+    return jz_gc_minor(jz);
+  }
+
+  /* Round up, so that every allocation pays for something. */
+  steps = (jz->gc.debt * jz->gc.speed + JZ_GC_STEP_BYTES - 1) / JZ_GC_STEP_BYTES;
+  jz->gc.debt = 0;
+
+  /* This won't run over into a new collection cycle. */
+  return timed_steps(jz, steps);
+}
+
+/* Does up to 'steps' steps, stopping early if that finishes the cycle,
+   and keeps track of how long each phase takes.
+   The clock's only read when the phase changes,
+   since steps can be very short. */
+jz_bool timed_steps(JZ_STATE, size_t steps) {
+  jz_byte phase = jz->gc.state;
+  double start = now();
+  jz_bool done = jz_false;
+
+  for (; steps > 0 && !done; steps--) {
+    done = jz_gc_step(jz);
+
+    if (jz->gc.state != phase) {
+      double end = now();
+
+      charge_time(jz, phase, end - start);
+      phase = jz->gc.state;
+      start = end;
+    }
+  }
+
+  if (!done) {
+    charge_time(jz, phase, now() - start);
+    return jz_false;
+  }
+
+  if (jz->gc.trace)
+    fprintf(stderr, "gc: major %lu: mark %.3f ms, sweep %.3f ms, "
+            "freed %lu bytes, %lu left, next at %lu\n",
+            jz->gc.stats.cycles,
+            jz->gc.stats.last_mark_time * 1000,
+            jz->gc.stats.last_sweep_time * 1000,
+            (unsigned long)jz->gc.stats.last_freed,
+            (unsigned long)jz->gc.allocated,
+            (unsigned long)jz->gc.threshold);
+  return jz_true;
+}
+
+/* Adds time spent in 'phase' to the stats.
+   The step that starts a cycle marks the roots,
+   so waiting counts as marking. */
+void charge_time(JZ_STATE, jz_byte phase, double seconds) {
+  switch (phase) {
+  case jz_gcs_waiting:
+  case jz_gcs_marking:
+    jz->gc.stats.mark_time += seconds;
+    jz->gc.stats.last_mark_time += seconds;
+    return;
+  case jz_gcs_sweeping:
+  case jz_gcs_lazy_sweeping:
+    jz->gc.stats.sweep_time += seconds;
+    jz->gc.stats.last_sweep_time += seconds;
+    return;
+  }
+}
+
+double now(void) {
+  struct timeval time;
+
+  gettimeofday(&time, NULL);
+  return time.tv_sec + time.tv_usec / 1e6;
+}
+
 jz_bool jz_gc_step(JZ_STATE) {
   switch (jz->gc.state) {
   case jz_gcs_waiting:
+    promote_nursery(jz);
+    forget_remembered(jz);
+    jz->gc.stats.last_mark_time = 0;
+    jz->gc.stats.last_sweep_time = 0;
+    jz->gc.stats.last_freed = 0;
     jz->gc.state = jz_gcs_marking;
     mark_roots(jz);
     return jz_false;
@@ -110,6 +744,7 @@ jz_bool jz_gc_step(JZ_STATE) {
     return jz_false;
 
   case jz_gcs_sweeping:
+  case jz_gcs_lazy_sweeping:
     return sweep_step(jz);
 
   default:
@@ -147,6 +782,9 @@ void blacken(JZ_STATE, jz_gc_header* obj) {
   case jz_t_enum:
     blacken_enum(jz, (jz_enum*)obj);
     break;
+  case jz_t_shape:
+    blacken_shape(jz, (jz_shape*)obj);
+    break;
   default:
     fprintf(stderr, "Unknown GC type %d\n", JZ_GC_TYPE(obj));
     exit(1);
@@ -158,14 +796,23 @@ void blacken(JZ_STATE, jz_gc_header* obj) {
 void blacken_obj(JZ_STATE, jz_obj* obj) {
   int i;
 
-  for (i = 0; i < obj->capacity; i++) {
-    jz_obj_cell* cell = obj->table + i;
+  if (obj->shape != NULL) {
+    /* The keys are referenced by the shape. */
+    jz_gc_mark_gray(jz, &obj->shape->gc);
 
-    if (cell->key == JZ_OBJ_EMPTY_KEY || cell->key == JZ_OBJ_REMOVED_KEY)
-      continue;
+    for (i = 0; i < obj->shape->size; i++)
+      JZ_GC_MARK_VAL_GRAY(jz, JZ_OBJ_SLOT(obj, i));
+  } else if (!JZ_OBJ_HAS_CELLS(obj)) {
+    /* The global cells are marked as roots. */
+    for (i = 0; i < obj->props.dict.capacity; i++) {
+      jz_obj_cell* cell = obj->props.dict.table + i;
+
+      if (cell->key == JZ_OBJ_EMPTY_KEY || cell->key == JZ_OBJ_REMOVED_KEY)
+        continue;
 
-    jz_gc_mark_gray(jz, &cell->key->gc);
-    JZ_GC_MARK_VAL_GRAY(jz, cell->value);
+      jz_gc_mark_gray(jz, &cell->key->gc);
+      JZ_GC_MARK_VAL_GRAY(jz, cell->value);
+    }
   }
 
   if (obj->prototype != NULL) {
@@ -199,8 +846,13 @@ void blacken_proto(JZ_STATE, jz_proto* proto) {
 void blacken_bytecode(JZ_STATE, jz_bytecode* code) {
   jz_val* next = code->consts;
   jz_val* top = next + code->consts_length;
+  jz_ic* ic = code->ics;
+  jz_ic* ics_top = ic + code->ics_length;
+
   for (; next != top; next++)
     JZ_GC_MARK_VAL_GRAY(jz, *next);
+  for (; ic != ics_top; ic++)
+    jz_ic_mark(jz, ic);
 }
 
 void blacken_cons(JZ_STATE, jz_cons* node) {
@@ -208,37 +860,128 @@ void blacken_cons(JZ_STATE, jz_cons* node) {
   JZ_GC_MARK_VAL_GRAY(jz, node->cdr);
 }
 
+/* The children and siblings are weak; see jz_shape_finalize. */
+void blacken_shape(JZ_STATE, jz_shape* shape) {
+  jz_gc_mark_gray(jz, (jz_gc_header*)shape->parent);
+  jz_gc_mark_gray(jz, (jz_gc_header*)shape->key);
+}
+
+void push_gray_stack(JZ_STATE, jz_gc_header* obj) {
+  if (jz->gc.gray_stack.length == jz->gc.gray_stack.capacity &&
+      !grow_gray_stack(jz)) {
+    jz->gc.gray_stack.overflowed = jz_true;
+    return;
+  }
+
+  jz->gc.gray_stack.objs[jz->gc.gray_stack.length++] = obj;
+}
+
 jz_gc_header* pop_gray_stack(JZ_STATE) {
-  jz_gc_node* node = jz->gc.gray_stack;
+  if (jz->gc.gray_stack.length == 0)
+    return NULL;
+  return jz->gc.gray_stack.objs[--jz->gc.gray_stack.length];
+}
+
+void drain_gray_stack(JZ_STATE) {
   jz_gc_header* obj;
 
-  if (node == NULL)
-    return NULL;
+  while ((obj = pop_gray_stack(jz)) != NULL)
+    blacken(jz, obj);
+}
 
-  obj = node->obj;
-  jz->gc.gray_stack = node->next;
-  free(node);
+/* Doubles the capacity of the gray stack.
+   Returns false if it's already as large as it's allowed to get
+   or if there isn't enough memory to grow it. */
+jz_bool grow_gray_stack(JZ_STATE) {
+  size_t capacity = jz->gc.gray_stack.capacity * 2;
+  jz_gc_header** objs;
 
-  return obj;
+  if (capacity > JZ_GC_GRAY_STACK_MAX)
+    return jz_false;
+
+  objs = realloc(jz->gc.gray_stack.objs, capacity * sizeof(jz_gc_header*));
+  if (objs == NULL)
+    return jz_false;
+
+  jz->gc.gray_stack.objs = objs;
+  jz->gc.gray_stack.capacity = capacity;
+  return jz_true;
+}
+
+/* Called when the gray stack has been emptied
+   but some objects were marked without being pushed onto it.
+   There's no telling which those were,
+   so every black object in the heap is blackened again.
+   That grays any white objects they refer to;
+   blackening an object twice does no harm.
+
+   The stack is drained after each object so that it has room,
+   but it can still overflow again,
+   in which case mark_step will call this again. */
+void rescan_heap(JZ_STATE) {
+  jz_gc_size_class* class = jz->gc.classes;
+  jz_gc_large* large;
+
+  jz->gc.gray_stack.overflowed = jz_false;
+
+  for (; class < jz->gc.classes + JZ_GC_SIZE_CLASSES; class++) {
+    jz_gc_page* page = class->pages;
+
+    for (; page != NULL; page = page->next) {
+      jz_byte* slot = PAGE_SLOTS(page);
+
+      for (; slot < page->top; slot += page->slot_size)
+        rescan_obj(jz, (jz_gc_header*)slot);
+    }
+  }
+
+  for (large = jz->gc.large_objs; large != NULL; large = large->next)
+    rescan_obj(jz, LARGE_OBJ(large));
+}
+
+/* Like rescan_heap, but for a minor collection.
+   Only young and remembered objects can be gray then,
+   and a lazy sweep may have left dead objects in the heap
+   that look black but mustn't be traced. */
+void rescan_young(JZ_STATE) {
+  size_t i;
+
+  jz->gc.gray_stack.overflowed = jz_false;
+
+  for (i = 0; i < jz->gc.nursery.length; i++)
+    rescan_obj(jz, jz->gc.nursery.objs[i].obj);
+  for (i = 0; i < jz->gc.remembered.length; i++)
+    rescan_obj(jz, jz->gc.remembered.objs[i]);
+}
+
+void rescan_obj(JZ_STATE, jz_gc_header* obj) {
+  if (JZ_GC_TYPE(obj) == jz_t_free || jz_gc_is_white(jz, obj))
+    return;
+
+  blacken(jz, obj);
+  drain_gray_stack(jz);
 }
 
 void mark_roots(JZ_STATE) {
-  jz_mark_frame(jz, jz->current_frame);
+  jz_frame* frame;
+
+  for (frame = jz->current_frame; frame != NULL; frame = frame->upper)
+    jz_mark_frame(jz, frame);
 
   if (jz->global_obj != NULL)
     jz_gc_mark_gray(jz, &jz->global_obj->gc);
 
   if (jz->prototypes != NULL)
     jz_gc_mark_gray(jz, &jz->prototypes->gc);
+
+  jz_gc_mark_gray(jz, (jz_gc_header*)jz->root_shape);
+  jz_cells_mark(jz);
 }
 
 void jz_mark_frame(JZ_STATE, jz_frame* frame) {
   jz_val* next;
   jz_val* top;
 
-  if (frame == NULL)
-    return;
-
   frame->mark = jz->gc.black_bit;
   jz_gc_mark_gray(jz, &frame->closure_locals->gc);
   jz_gc_mark_gray(jz, &frame->function->gc);
@@ -252,56 +995,101 @@ void jz_mark_frame(JZ_STATE, jz_frame* frame) {
   }
 
   jz_gc_mark_gray(jz, &frame->bytecode->gc);
-
-  jz_mark_frame(jz, frame->upper);
 }
 
 void mark_step(JZ_STATE) {
   jz_gc_header* obj = pop_gray_stack(jz);
-  if (obj == NULL) {
+  if (obj == NULL && jz->gc.gray_stack.overflowed) {
+    rescan_heap(jz);
+    return;
+  } else if (obj == NULL) {
     jz->gc.black_bit = !jz->gc.black_bit;
-    jz->gc.state = jz_gcs_sweeping;
+    start_sweep(jz);
   }
   else blacken(jz, obj);
   return;
 }
 
+void start_sweep(JZ_STATE) {
+  jz_gc_size_class* class = jz->gc.classes;
+
+  for (; class < jz->gc.classes + JZ_GC_SIZE_CLASSES; class++) {
+    class->sweep_page = class->pages;
+    class->sweep_slot = class->pages == NULL ? NULL : PAGE_SLOTS(class->pages);
+  }
+  jz->gc.sweep_class = 0;
+  jz->gc.sweep_large = jz->gc.large_objs;
+
+#if JZ_GC_THREADS > 1
+  if (jz->gc.background_sweep) {
+    start_sweeper(jz);
+    return;
+  }
+#endif
+
+  if (!jz->gc.lazy_sweep) {
+    jz->gc.state = jz_gcs_sweeping;
+    return;
+  }
+
+  /* The garbage hasn't been subtracted from jz->gc.allocated yet,
+     so this is generous, but it's recalculated in finish_cycle. */
+  jz->gc.state = jz_gcs_lazy_sweeping;
+  jz->gc.threshold = (jz->gc.pause * jz->gc.allocated)/100;
+  if (jz->gc.threshold < JZ_GC_MIN_THRESHOLD)
+    jz->gc.threshold = JZ_GC_MIN_THRESHOLD;
+}
+
+/* Looks at up to JZ_GC_SWEEP_BUDGET slots or large objects,
+   freeing whichever are dead.
+   The size classes are swept in turn, and then the large objects. */
 jz_bool sweep_step(JZ_STATE) {
-  jz_gc_header* prev = jz->gc.prev_sweep_obj;
-  jz_gc_header* next = jz->gc.next_sweep_obj;
+  size_t budget = JZ_GC_SWEEP_BUDGET;
+  jz_gc_large* large;
 
   /* By the time we reach this function,
      the white and black bits have been flipped.
      Thus, black objects are colletable and white objects are not. */
 
-  if (next == NULL) {
-    next = jz->gc.all_objs;
+  while (jz->gc.sweep_class < JZ_GC_SIZE_CLASSES) {
+    jz_gc_size_class* class = jz->gc.classes + jz->gc.sweep_class;
 
-    if (next == NULL) {
-      /* For some reason, there are no heap-allocated objects. */
-      finish_cycle(jz);
-      return jz_true;
+    if (class->sweep_page == NULL) {
+      jz->gc.sweep_class++;
+      continue;
     }
 
-    if (jz_gc_is_black(jz, next)) {
-      jz->gc.all_objs = next->next;
-      gc_free(jz, next);
+    budget -= sweep_slots(jz, class, budget);
+    if (budget == 0)
       return jz_false;
-    }
   }
 
-  for (; next != NULL; prev = next, next = next->next) {
-    if (jz_gc_is_white(jz, next))
-      continue;
+#if JZ_GC_THREADS > 1
+  if (jz->gc.sweeper != NULL) {
+    budget -= finalize_dead(jz, budget);
+    if (budget == 0)
+      return jz_false;
+  }
+#endif
 
-    prev->next = next->next;
-    gc_free(jz, next);
+  for (large = jz->gc.sweep_large; large != NULL && budget > 0; budget--) {
+    jz_gc_large* next = large->next;
 
-    jz->gc.prev_sweep_obj = prev;
-    jz->gc.next_sweep_obj = prev->next;
+    if (!jz_gc_is_white(jz, LARGE_OBJ(large))) {
+      finalize(jz, LARGE_OBJ(large));
+      release_large(jz, large);
+    }
+    large = next;
+  }
 
+  jz->gc.sweep_large = large;
+  if (large != NULL)
     return jz_false;
-  }
+
+#if JZ_GC_THREADS > 1
+  if (jz->gc.sweeper != NULL && !finish_sweeper(jz))
+    return jz_false;
+#endif
 
   /* No more black (sweepable) objects left. */
   finish_cycle(jz);
@@ -309,25 +1097,265 @@ jz_bool sweep_step(JZ_STATE) {
   return jz_true;
 }
 
-void gc_free(JZ_STATE, jz_gc_header* obj) {
+/* Sweeps up to 'budget' of a size class's slots,
+   picking up where it last left off.
+   Returns the number of slots it looked at,
+   which is less than 'budget' only if the class is done. */
+size_t sweep_slots(JZ_STATE, jz_gc_size_class* class, size_t budget) {
+  jz_gc_page* page = class->sweep_page;
+  jz_byte* slot = class->sweep_slot;
+  size_t examined = 0;
+
+  while (page != NULL && examined < budget) {
+    for (; slot < page->top && examined < budget;
+         slot += page->slot_size, examined++) {
+      jz_gc_header* obj = (jz_gc_header*)slot;
+
+      if (JZ_GC_TYPE(obj) == jz_t_free || jz_gc_is_white(jz, obj))
+        continue;
+
+      finalize(jz, obj);
+      release_small(jz, obj, page->slot_size);
+    }
+
+    if (slot >= page->top) {
+      page = page->next;
+      slot = page == NULL ? NULL : PAGE_SLOTS(page);
+    }
+  }
+
+  class->sweep_page = page;
+  class->sweep_slot = slot;
+  return examined;
+}
+
+/* Frees anything a dead object owns outside the GC heap.
+   The object itself is released by the sweeper. */
+void finalize(JZ_STATE, jz_gc_header* obj) {
   switch (JZ_GC_TYPE(obj)) {
   case jz_t_obj:
-    jz_obj_free(jz, (jz_obj*)obj);
+    jz_obj_finalize(jz, (jz_obj*)obj);
     return;
   case jz_t_bytecode:
-    jz_free_bytecode(jz, (jz_bytecode*)obj);
+    jz_finalize_bytecode(jz, (jz_bytecode*)obj);
+    return;
+  case jz_t_str:
+    if (JZ_STR_IS_ATOM((jz_str*)obj))
+      jz_str_remove_atom(jz, (jz_str*)obj);
+    return;
+  case jz_t_shape:
+    jz_shape_finalize(jz, (jz_shape*)obj);
     return;
   default:
-    free(obj);
+    return;
+  }
+}
+
+#if JZ_GC_THREADS > 1
+void start_sweeper(JZ_STATE) {
+  jz_gc_sweeper* sweeper = calloc(1, sizeof(jz_gc_sweeper));
+  int i;
+
+  sweeper->jz = jz;
+  for (i = 0; i < JZ_GC_SIZE_CLASSES; i++) {
+    jz_gc_size_class* class = jz->gc.classes + i;
+
+    sweeper->pages[i] = class->sweep_page;
+    class->sweep_page = NULL;
+    class->sweep_slot = NULL;
+
+    /* These are all in the sweeper's pages,
+       so it'll find them again. */
+    class->free_slots = NULL;
+    /* The sweeper frees up whatever's left of this page,
+       so nothing more can be carved out of it. */
+    class->page = NULL;
+  }
+
+  pthread_mutex_init(&sweeper->lock, NULL);
+  jz->gc.sweeper = sweeper;
+  jz->gc.state = jz_gcs_sweeping;
+
+  if (pthread_create(&sweeper->thread, NULL, run_sweeper, sweeper)) {
+    fprintf(stderr, "Couldn't create a GC thread.\n");
+    exit(1);
   }
 }
 
+void* run_sweeper(void* sweeper) {
+  jz_gc_sweeper* self = sweeper;
+  int i;
+
+  for (i = 0; i < JZ_GC_SIZE_CLASSES; i++) {
+    jz_gc_page* page = self->pages[i];
+
+    for (; page != NULL; page = page->next)
+      sweep_page(self, i, page);
+  }
+
+  pthread_mutex_lock(&self->lock);
+  self->done = jz_true;
+  pthread_mutex_unlock(&self->lock);
+  return NULL;
+}
+
+/* Sweeps a page, then hands its free slots and its dead objects
+   over to the mutator all at once. */
+void sweep_page(jz_gc_sweeper* self, int class_index, jz_gc_page* page) {
+  jz_state* jz = self->jz;
+  dead_obj dead[JZ_GC_PAGE_SIZE / JZ_GC_GRANULE];
+  size_t dead_length = 0;
+  jz_gc_header* head = NULL;
+  jz_gc_header* tail = NULL;
+  size_t freed = 0;
+  jz_byte* slot = PAGE_SLOTS(page);
+
+  for (; slot < page->end; slot += page->slot_size) {
+    jz_gc_header* obj = (jz_gc_header*)slot;
+
+    /* The slots past the top have never been handed out. */
+    if (slot < page->top) {
+      /* The mutator may be setting other bits in live objects' tags. */
+      jz_tag tag = __atomic_load_n(&JZ_GC_TAG(obj), __ATOMIC_RELAXED);
+
+      if (JZ_TAG_TYPE(tag) != jz_t_free) {
+        if (JZ_BIT(tag, JZ_GC_FLAG_BIT) != jz->gc.black_bit)
+          continue;
+
+        if (JZ_TAG_TYPE(tag) == jz_t_obj ||
+            JZ_TAG_TYPE(tag) == jz_t_bytecode ||
+            JZ_TAG_TYPE(tag) == jz_t_shape ||
+            (JZ_TAG_TYPE(tag) == jz_t_str && JZ_STR_IS_ATOM((jz_str*)obj))) {
+          dead[dead_length].obj = obj;
+          dead[dead_length].size = page->slot_size;
+          dead_length++;
+          continue;
+        }
+
+        freed += page->slot_size;
+      }
+    }
+
+    JZ_GC_TAG(obj) = 0;
+    JZ_GC_SET_TYPE(obj, jz_t_free);
+    ((free_slot*)obj)->next = head;
+    head = obj;
+    if (tail == NULL)
+      tail = obj;
+  }
+  page->top = page->end;
+
+  pthread_mutex_lock(&self->lock);
+  if (head != NULL) {
+    ((free_slot*)tail)->next = self->swept[class_index];
+    if (self->swept[class_index] == NULL)
+      self->swept_tail[class_index] = tail;
+    self->swept[class_index] = head;
+  }
+
+  while (self->dead_length + dead_length > self->dead_capacity)
+    self->dead = grow_array(self->dead, &self->dead_capacity, sizeof(dead_obj));
+  memcpy(self->dead + self->dead_length, dead, dead_length * sizeof(dead_obj));
+  self->dead_length += dead_length;
+
+  self->freed += freed;
+  pthread_mutex_unlock(&self->lock);
+}
+
+/* Gives the allocator whatever slots of this class have been swept. */
+void take_swept(JZ_STATE, jz_gc_size_class* class) {
+  jz_gc_sweeper* sweeper = jz->gc.sweeper;
+  int i = class - jz->gc.classes;
+
+  pthread_mutex_lock(&sweeper->lock);
+  class->free_slots = sweeper->swept[i];
+  sweeper->swept[i] = NULL;
+  jz->gc.allocated -= sweeper->freed;
+  jz->gc.stats.last_freed += sweeper->freed;
+  jz->gc.stats.background_freed += sweeper->freed;
+  sweeper->freed = 0;
+  pthread_mutex_unlock(&sweeper->lock);
+}
+
+/* Finalizes and frees up to 'budget' of the objects
+   that the sweeper's handed back.
+   Returns the number it did. */
+size_t finalize_dead(JZ_STATE, size_t budget) {
+  jz_gc_sweeper* sweeper = jz->gc.sweeper;
+  size_t done = 0;
+
+  pthread_mutex_lock(&sweeper->lock);
+  for (; done < budget && sweeper->dead_length > 0; done++) {
+    dead_obj* dead = sweeper->dead + --sweeper->dead_length;
+
+    finalize(jz, dead->obj);
+    release_small(jz, dead->obj, dead->size);
+  }
+  pthread_mutex_unlock(&sweeper->lock);
+
+  return done;
+}
+
+/* Blocks until the sweeper's done with the pages,
+   for when there's nothing else to do. */
+void wait_for_sweeper(JZ_STATE) {
+  jz_gc_sweeper* sweeper = jz->gc.sweeper;
+
+  if (sweeper == NULL || sweeper->joined)
+    return;
+
+  pthread_join(sweeper->thread, NULL);
+  sweeper->joined = jz_true;
+}
+
+/* Once the sweeper's done and everything it's handed back is finalized,
+   gives the allocator the rest of the free slots and gets rid of it.
+   Returns whether that happened. */
+jz_bool finish_sweeper(JZ_STATE) {
+  jz_gc_sweeper* sweeper = jz->gc.sweeper;
+  jz_bool done;
+  int i;
+
+  pthread_mutex_lock(&sweeper->lock);
+  done = sweeper->done && sweeper->dead_length == 0;
+  pthread_mutex_unlock(&sweeper->lock);
+
+  if (!done)
+    return jz_false;
+
+  wait_for_sweeper(jz);
+
+  for (i = 0; i < JZ_GC_SIZE_CLASSES; i++) {
+    jz_gc_size_class* class = jz->gc.classes + i;
+
+    if (sweeper->swept[i] == NULL)
+      continue;
+
+    ((free_slot*)sweeper->swept_tail[i])->next = class->free_slots;
+    class->free_slots = sweeper->swept[i];
+  }
+  jz->gc.allocated -= sweeper->freed;
+  jz->gc.stats.last_freed += sweeper->freed;
+  jz->gc.stats.background_freed += sweeper->freed;
+
+  pthread_mutex_destroy(&sweeper->lock);
+  free(sweeper->dead);
+  free(sweeper);
+  jz->gc.sweeper = NULL;
+
+  return jz_true;
+}
+#endif
+
 void finish_cycle(JZ_STATE) {
-  jz->gc.prev_sweep_obj = NULL;
-  jz->gc.next_sweep_obj = NULL;
+  jz->gc.stats.cycles++;
+  jz->gc.stats.freed += jz->gc.stats.last_freed;
+  jz->gc.sweep_class = 0;
+  jz->gc.sweep_large = NULL;
   jz->gc.state = jz_gcs_waiting;
   jz->gc.threshold = (jz->gc.pause * jz->gc.allocated)/100;
-  assert(jz->gc.threshold > 0);
+  if (jz->gc.threshold < JZ_GC_MIN_THRESHOLD)
+    jz->gc.threshold = JZ_GC_MIN_THRESHOLD;
 }
 
 void jz_gc_init(JZ_STATE) {
@@ -336,9 +1364,132 @@ void jz_gc_init(JZ_STATE) {
   jz->gc.pause = JZ_GC_DEFAULT_PAUSE;
   jz->gc.allocated = 0;
   jz->gc.threshold = 1;
+  jz->gc.debt = 0;
   jz->gc.black_bit = jz_false;
-  jz->gc.all_objs = NULL;
-  jz->gc.gray_stack = NULL;
-  jz->gc.prev_sweep_obj = NULL;
-  jz->gc.next_sweep_obj = NULL;
+  jz->gc.lazy_sweep = getenv("JZ_GC_LAZY_SWEEP") != NULL;
+  jz->gc.background_sweep = getenv("JZ_GC_BACKGROUND_SWEEP") != NULL;
+  jz->gc.sweeper = NULL;
+  jz->gc.worker = NULL;
+  memset(&jz->gc.stats, 0, sizeof(jz->gc.stats));
+  jz->gc.trace = getenv("JZ_GC_TRACE") != NULL;
+  jz->gc.snapshot = NULL;
+  memset(jz->gc.classes, 0, sizeof(jz->gc.classes));
+  jz->gc.large_objs = NULL;
+  memset(&jz->gc.nursery, 0, sizeof(jz->gc.nursery));
+  memset(&jz->gc.remembered, 0, sizeof(jz->gc.remembered));
+  memset(&jz->gc.remembered_slots, 0, sizeof(jz->gc.remembered_slots));
+  jz->gc.gray_stack.objs = malloc(JZ_GC_GRAY_STACK_MIN * sizeof(jz_gc_header*));
+  jz->gc.gray_stack.length = 0;
+  jz->gc.gray_stack.capacity = JZ_GC_GRAY_STACK_MIN;
+  jz->gc.gray_stack.overflowed = jz_false;
+  jz->gc.sweep_class = 0;
+  jz->gc.sweep_large = NULL;
+}
+
+void jz_gc_get_stats(JZ_STATE, jz_gc_stats* stats) {
+  jz_gc_size_class* class = jz->gc.classes;
+  jz_gc_large* large;
+
+  /* The sweeper's pages can't be looked at until it's done. */
+  wait_for_sweeper(jz);
+
+  *stats = jz->gc.stats;
+  stats->allocated = jz->gc.allocated;
+  stats->threshold = jz->gc.threshold;
+  stats->heap_size = 0;
+  stats->atom_capacity = jz->atoms.capacity;
+  memset(stats->objects, 0, sizeof(stats->objects));
+
+  for (; class < jz->gc.classes + JZ_GC_SIZE_CLASSES; class++) {
+    jz_gc_page* page = class->pages;
+
+    for (; page != NULL; page = page->next) {
+      jz_byte* slot = PAGE_SLOTS(page);
+
+      stats->heap_size += JZ_GC_PAGE_SIZE;
+      for (; slot < page->top; slot += page->slot_size) {
+        jz_gc_header* obj = (jz_gc_header*)slot;
+
+        /* While sweeping, black objects are garbage. */
+        if (JZ_GC_TYPE(obj) == jz_t_free ||
+            (jz_gc_sweeping(jz) && jz_gc_is_black(jz, obj)))
+          continue;
+        stats->objects[JZ_GC_TYPE(obj)]++;
+      }
+    }
+  }
+
+  for (large = jz->gc.large_objs; large != NULL; large = large->next) {
+    jz_gc_header* obj = LARGE_OBJ(large);
+
+    stats->heap_size += large->size;
+    if (!jz_gc_sweeping(jz) || !jz_gc_is_black(jz, obj))
+      stats->objects[JZ_GC_TYPE(obj)]++;
+  }
+}
+
+void jz_gc_snapshot(JZ_STATE, FILE* file) {
+  jz_gc_size_class* class = jz->gc.classes;
+  jz_gc_large* large;
+
+  /* Get rid of the garbage, so that only what's reachable is left. */
+  jz_gc_cycle(jz);
+
+  /* Blackening an object now writes out what it refers to. */
+  jz->gc.state = jz_gcs_snapshot;
+  jz->gc.snapshot = file;
+
+  fprintf(file, "0 roots 0");
+  mark_roots(jz);
+  fprintf(file, "\n");
+
+  for (; class < jz->gc.classes + JZ_GC_SIZE_CLASSES; class++) {
+    jz_gc_page* page = class->pages;
+
+    for (; page != NULL; page = page->next) {
+      jz_byte* slot = PAGE_SLOTS(page);
+
+      for (; slot < page->top; slot += page->slot_size)
+        snapshot_obj(jz, (jz_gc_header*)slot, page->slot_size);
+    }
+  }
+
+  for (large = jz->gc.large_objs; large != NULL; large = large->next)
+    snapshot_obj(jz, LARGE_OBJ(large), large->size);
+
+  jz->gc.snapshot = NULL;
+  jz->gc.state = jz_gcs_waiting;
+}
+
+void snapshot_obj(JZ_STATE, jz_gc_header* obj, size_t size) {
+  if (JZ_GC_TYPE(obj) == jz_t_free)
+    return;
+
+  fprintf(jz->gc.snapshot, "%lx %s %lu", (unsigned long)(jz_ival)obj,
+          jz_gc_type_names[JZ_GC_TYPE(obj)], (unsigned long)size);
+  blacken(jz, obj);
+  fprintf(jz->gc.snapshot, "\n");
+}
+
+void jz_gc_free(JZ_STATE) {
+  jz_gc_size_class* class = jz->gc.classes;
+
+  free(jz->gc.gray_stack.objs);
+  free(jz->gc.nursery.objs);
+  free(jz->gc.remembered.objs);
+  free(jz->gc.remembered_slots.slots);
+
+  for (; class < jz->gc.classes + JZ_GC_SIZE_CLASSES; class++) {
+    while (class->pages != NULL) {
+      jz_gc_page* page = class->pages;
+      class->pages = page->next;
+      free(page);
+    }
+  }
+
+  while (jz->gc.large_objs != NULL) {
+    jz_gc_large* large = jz->gc.large_objs;
+    jz->gc.large_objs = large->next;
+    free(large);
+  }
 }
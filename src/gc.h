@@ -2,27 +2,127 @@
 #define JZ_GC_H
 
 #include <stdlib.h>
+#include <stdio.h>
 
 #include "jazz.h"
 #include "value.h"
 
-typedef struct jz_gc_node jz_gc_node;
-struct jz_gc_node {
-  jz_gc_node* next;
-  jz_gc_header* obj;
-};
-
 typedef enum {
   jz_gcs_waiting,
   jz_gcs_marking,
-  jz_gcs_sweeping
+  jz_gcs_sweeping,
+  jz_gcs_lazy_sweeping, /* See jz_gc_set_lazy_sweep. */
+  jz_gcs_minor, /* Only while jz_gc_minor is running. */
+  jz_gcs_snapshot /* Only while jz_gc_snapshot is running. */
 } jz_gc_state;
 
+/* The names of the GC types, indexed by jz_type. */
+const char* jz_gc_type_names[jz_t_free];
+
+/* During a collection, jz->gc.speed steps are done
+   for every JZ_GC_STEP_BYTES that are allocated.
+   A new collection starts once the heap has grown
+   to jz->gc.pause percent of its size after the last one. */
 #define JZ_GC_DEFAULT_SPEED 2
 #define JZ_GC_DEFAULT_PAUSE 150
+#define JZ_GC_STEP_BYTES 32
+
+/* The threshold never drops below this many bytes,
+   so that small heaps aren't collected over and over. */
+#define JZ_GC_MIN_THRESHOLD (1 << 18)
+
+/* A minor collection runs once this many bytes
+   have been allocated since the last collection.
+   See jz_gc_minor. */
+#define JZ_GC_NURSERY_SIZE (1 << 17)
+
+/* Objects of up to JZ_GC_SIZE_CLASSES * JZ_GC_GRANULE bytes
+   are allocated from pages of JZ_GC_PAGE_SIZE bytes,
+   each of which is divided into equally-sized slots.
+   There's a separate set of pages for each multiple of JZ_GC_GRANULE.
+   Larger objects are allocated individually. */
+#define JZ_GC_PAGE_SIZE (1 << 14)
+#define JZ_GC_GRANULE 16
+#define JZ_GC_SIZE_CLASSES 16
+
+/* The gray stack starts with room for JZ_GC_GRAY_STACK_MIN objects
+   and doubles as needed up to JZ_GC_GRAY_STACK_MAX.
+   Once it's full, objects are marked without being pushed
+   and found again by rescanning the heap. */
+#define JZ_GC_GRAY_STACK_MIN 256
+#define JZ_GC_GRAY_STACK_MAX (1 << 20)
+
+/* With JZ_GC_THREADS > 1,
+   jz_gc_cycle marks heaps of at least this many bytes in parallel. */
+#define JZ_GC_PARALLEL_HEAP (1 << 23)
+
+#ifndef JZ_GC_THREADS
+#define JZ_GC_THREADS 1
+#endif
+
+typedef struct jz_gc_page jz_gc_page;
+typedef struct jz_gc_large jz_gc_large;
+typedef struct jz_gc_worker jz_gc_worker;
+typedef struct jz_gc_sweeper jz_gc_sweeper;
+
+/* An object allocated since the last collection. */
+typedef struct {
+  jz_gc_header* obj;
+  size_t size; /* The size of its slot. */
+} jz_gc_young;
+
+typedef struct {
+  jz_gc_page* pages;
+  jz_gc_page* page; /* The page that new slots are carved out of. */
+  jz_gc_header* free_slots; /* Slots that have been freed by the sweeper. */
+
+  /* Where the sweeper will pick up from in this class.
+     NULL unless sweeping. */
+  jz_gc_page* sweep_page;
+  jz_byte* sweep_slot;
+} jz_gc_size_class;
+
+/* What the collector has been up to since jz_gc_init,
+   along with a snapshot of the heap.
+   See jz_gc_get_stats. */
+typedef struct {
+  size_t allocated; /* Bytes in objects, including unswept garbage. */
+  size_t threshold;
+  size_t heap_size; /* Bytes in pages and large objects. */
+  size_t atom_capacity; /* Slots in the atom table (see jz_str_intern). */
+
+  unsigned long cycles; /* Major collections finished. */
+  unsigned long minors;
+  size_t freed; /* Bytes reclaimed by major collections. */
+  /* Bytes the allocator swept up for itself during lazy sweeps;
+     see jz_gc_set_lazy_sweep. */
+  size_t lazy_freed;
+  /* Bytes the background sweeper has handed over to the allocator;
+     see jz_gc_set_background_sweep. */
+  size_t background_freed;
+  size_t minor_freed;
+  size_t promoted; /* Bytes in young objects that survived a minor collection. */
+
+  /* Seconds spent on each sort of work. */
+  double mark_time;
+  double sweep_time;
+  double minor_time;
+
+  /* The same, for the current or most recent major collection. */
+  double last_mark_time;
+  double last_sweep_time;
+  size_t last_freed;
+
+  /* The number of objects of each type.
+     Once a collection's done marking, this leaves out the garbage,
+     but before that there's no telling which objects are garbage. */
+  size_t objects[jz_t_free];
+} jz_gc_stats;
+
+/* The number of slots or large objects each sweep step looks at. */
+#define JZ_GC_SWEEP_BUDGET 256
 
 #define JZ_GC_TAG(obj) (((jz_gc_header*)obj)->tag)
-#define JZ_GC_NEXT(obj) (((jz_gc_header*)obj)->next)
 
 #define JZ_GC_TYPE(obj) (JZ_TAG_TYPE(JZ_GC_TAG(obj)))
 #define JZ_GC_SET_TYPE(obj, type) \
@@ -31,6 +131,15 @@ typedef enum {
 #define JZ_GC_FLAG_BIT 0
 #define JZ_GC_FLAG(obj) (JZ_BIT(JZ_GC_TAG(obj), JZ_GC_FLAG_BIT))
 
+/* Set for objects that have survived a collection.
+   Young objects are the ones in jz->gc.nursery.
+
+   Old objects in the remembered set have this cleared
+   until the next minor collection,
+   so that they're traced and only added once. */
+#define JZ_GC_OLD_BIT 1
+#define jz_gc_is_old(obj) (JZ_BIT(JZ_GC_TAG(obj), JZ_GC_OLD_BIT))
+
 #define jz_gc_is_white(jz, obj)                 \
   (JZ_GC_FLAG(obj) == !jz->gc.black_bit)
 #define jz_gc_is_black(jz, obj)                 \
@@ -42,15 +151,31 @@ typedef enum {
    jz_false)
 
 #define jz_gc_write_barrier_active(jz) (jz->gc.state == jz_gcs_marking)
-#define jz_gc_paused(jz) (jz->gc.state == jz_gcs_waiting)
+/* A lazy sweep is driven by the allocator rather than by safepoints,
+   so as far as the mutator's concerned the collector is idle. */
+#define jz_gc_paused(jz)                                \
+  (jz->gc.state == jz_gcs_waiting ||                    \
+   jz->gc.state == jz_gcs_lazy_sweeping)
+#define jz_gc_sweeping(jz)                              \
+  (jz->gc.state == jz_gcs_sweeping ||                   \
+   jz->gc.state == jz_gcs_lazy_sweeping)
 #define jz_gc_within_threshold(jz) (jz->gc.allocated < jz->gc.threshold)
+#define jz_gc_nursery_full(jz) (jz->gc.nursery.bytes >= JZ_GC_NURSERY_SIZE)
 
-#define JZ_GC_WRITE_BARRIER(jz, referrer, reference)            \
-  ((referrer && reference &&                                    \
-    jz_gc_write_barrier_active(jz) &&                           \
-    jz_gc_is_black(jz, (jz_gc_header*)(referrer)) &&            \
-    jz_gc_is_white(jz, (jz_gc_header*)(reference))) ?           \
-   jz_gc_mark_gray(jz, (jz_gc_header*)(reference)) : jz_false)
+/* While marking, this keeps black objects from referring to white ones.
+   Otherwise, it adds old objects that are made to refer to young ones
+   to the remembered set.
+   There are no young objects during a major collection,
+   so the second case never comes up then. */
+#define JZ_GC_WRITE_BARRIER(jz, referrer, reference)                    \
+  ((!(referrer) || !(reference)) ? jz_false :                           \
+   jz_gc_write_barrier_active(jz) ?                                     \
+   ((jz_gc_is_black(jz, (jz_gc_header*)(referrer)) &&                   \
+     jz_gc_is_white(jz, (jz_gc_header*)(reference))) ?                  \
+    jz_gc_mark_gray(jz, (jz_gc_header*)(reference)) : jz_false) :       \
+   (jz_gc_is_old((jz_gc_header*)(referrer)) &&                          \
+    !jz_gc_is_old((jz_gc_header*)(reference))) ?                        \
+   jz_gc_remember(jz, (jz_gc_header*)(referrer)) : jz_false)
 
 #define JZ_GC_WRITE_BARRIER_VAL(jz, referrer, val) {    \
     if (JZ_VAL_CAN_BE_GCED(val)) {                      \
@@ -59,24 +184,93 @@ typedef enum {
     }                                                   \
   }
 
+/* For stores through a jz_val* whose owner isn't known,
+   such as closure variables.
+   These don't need the marking barrier,
+   since the value has always just come off the VM stack,
+   where it was grayed on the way in. */
+#define JZ_GC_WRITE_BARRIER_SLOT(jz, slot, val)                         \
+  ((JZ_VAL_CAN_BE_GCED(val) && !jz_gc_is_old((jz_gc_header*)(val))) ?   \
+   jz_gc_remember_slot(jz, slot) : jz_false)
+
 jz_gc_header* jz_gc_malloc(JZ_STATE, jz_type type, size_t size);
 jz_gc_header* jz_gc_dyn_malloc(JZ_STATE, jz_type type, size_t struct_size,
                             size_t extra_size, size_t number);
 
-#define jz_gc_tick(jz)                                          \
-  ((jz_gc_within_threshold(jz) && jz_gc_paused(jz)) ? jz_false :   \
-   jz_gc_steps(jz))
+/* Allocating runs up a debt, which is paid off in GC work
+   the next time the VM reaches a safepoint
+   (a jump, a call, or the start of a function).
+   Work can't happen during the allocation itself,
+   since the caller may be holding new objects in C variables
+   that the collector can't see.
+
+   No debt is run up between collections
+   until a new one is due. */
+#define jz_gc_safepoint(jz) ((jz)->gc.debt > 0 ? jz_gc_pay(jz) : jz_false)
+jz_bool jz_gc_pay(JZ_STATE);
 
 void jz_gc_cycle(JZ_STATE);
-jz_bool jz_gc_steps(JZ_STATE);
+
+/* Fills in 'stats'.
+   This walks the whole heap to count the objects,
+   so it's not something to do often.
+
+   If the JZ_GC_TRACE environment variable is set,
+   a line about each collection is also printed to stderr. */
+void jz_gc_get_stats(JZ_STATE, jz_gc_stats* stats);
+
+/* Does a full collection, then writes every object left to 'file',
+   one per line:
+
+     <address> <type> <size> <reference> <reference> ...
+
+   The size is that of the object's slot,
+   so it leaves out anything the object has malloc'd.
+   The references are the objects it'd mark, in hex like the address.
+   The first line stands for the roots:
+   its address is 0, its type is "roots", and its size is 0.
+
+   See heapdom.c for something to do with the result. */
+void jz_gc_snapshot(JZ_STATE, FILE* file);
+
+/* Collects only the objects allocated since the last collection,
+   all at once, tracing from the roots and the remembered set.
+   Survivors become old.
+   This may only be called while jz_gc_paused. */
+jz_bool jz_gc_minor(JZ_STATE);
 jz_bool jz_gc_step(JZ_STATE);
 
 #define jz_gc_set_speed(jz, new_speed) ((jz)->gc.speed = (new_speed))
 #define jz_gc_set_pause(jz, new_pause) ((jz)->gc.pause = (new_pause))
 
+/* With lazy sweeping, dead objects are only swept
+   when the allocator runs out of free slots of their size,
+   or once the threshold for the next collection is reached.
+   Otherwise, they're swept a chunk at a time at safepoints
+   as soon as marking finishes.
+   It's off unless the JZ_GC_LAZY_SWEEP environment variable is set
+   or a script calls gc.setLazySweep(true). */
+#define jz_gc_set_lazy_sweep(jz, lazy) ((jz)->gc.lazy_sweep = (lazy))
+
+/* With background sweeping, the size classes are swept
+   on a thread of their own as soon as marking finishes.
+   Dead objects that need finalizing are handed back to this thread
+   and finalized at safepoints, along with the large objects.
+   This takes precedence over lazy sweeping,
+   and does nothing unless JZ_GC_THREADS > 1.
+   It's off unless the JZ_GC_BACKGROUND_SWEEP environment variable is set
+   or a script calls gc.setBackgroundSweep(true). */
+#define jz_gc_set_background_sweep(jz, on) ((jz)->gc.background_sweep = (on))
+
 jz_bool jz_gc_mark_gray(JZ_STATE, jz_gc_header* obj);
+jz_bool jz_gc_remember(JZ_STATE, jz_gc_header* obj);
+jz_bool jz_gc_remember_slot(JZ_STATE, jz_val* slot);
+/* Marks what 'frame' refers to, but not the frames above it. */
 void jz_mark_frame(JZ_STATE, jz_frame* frame);
 
 void jz_gc_init(JZ_STATE);
 
+/* Frees every object without finalizing it, along with the pages. */
+void jz_gc_free(JZ_STATE);
+
 #endif
@@ -0,0 +1,399 @@
+/* Reads a heap snapshot written by jz_gc_snapshot (see gc.h)
+   and prints where the memory is being kept alive.
+
+   Usage: heapdom <snapshot> [count]
+
+   An object dominates another if every path from the roots to the other
+   goes through it, so freeing the dominator would free the other as well.
+   An object's retained size is its own size
+   plus the sizes of everything it dominates.
+   The dominators are found with the algorithm from
+   "A Simple, Fast Dominance Algorithm" by Cooper, Harvey, and Kennedy.
+
+   This prints the total size of each type,
+   then the 'count' objects (20 by default) with the largest retained sizes,
+   along with the objects that dominate them. */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TOKEN_LENGTH 64
+#define MAX_TYPES 32
+#define CHAIN_LENGTH 6
+#define UNDEFINED ((size_t)-1)
+
+typedef struct {
+  unsigned long address;
+  int type;
+  size_t size;
+  size_t first_edge; /* Into the graph's edges. */
+  size_t edges;
+  size_t retained;
+} node;
+
+typedef struct {
+  node* nodes;
+  size_t length;
+  size_t capacity;
+
+  /* The addresses that nodes refer to,
+     which become node indices once all the nodes are in. */
+  unsigned long* edges;
+  size_t edges_length;
+  size_t edges_capacity;
+
+  char types[MAX_TYPES][TOKEN_LENGTH];
+  int types_length;
+
+  /* Maps addresses to node indices. */
+  size_t* table;
+  size_t table_capacity;
+} graph;
+
+static void* grow(void* array, size_t* capacity, size_t size);
+static int read_token(FILE* file, char* token);
+static void read_graph(FILE* file, graph* g);
+static int type_index(graph* g, const char* name);
+static void index_nodes(graph* g);
+static size_t find_node(graph* g, unsigned long address);
+static size_t* reverse_postorder(graph* g, size_t* length);
+static size_t* dominators(graph* g, size_t* order, size_t length);
+static size_t intersect(size_t* idom, size_t* rank, size_t a, size_t b);
+static int by_retained(const void* a, const void* b);
+static void print_report(graph* g, size_t* idom, size_t count);
+
+static graph* sort_graph;
+
+int main(int argc, char** argv) {
+  FILE* file;
+  graph g;
+  size_t* order;
+  size_t* idom;
+  size_t length;
+  size_t i;
+
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s <snapshot> [count]\n", argv[0]);
+    return 1;
+  }
+
+  file = fopen(argv[1], "r");
+  if (file == NULL) {
+    fprintf(stderr, "File does not exist: %s\n", argv[1]);
+    return 1;
+  }
+
+  memset(&g, 0, sizeof(g));
+  read_graph(file, &g);
+  fclose(file);
+
+  if (g.length == 0 || g.nodes[0].address != 0) {
+    fprintf(stderr, "%s isn't a heap snapshot.\n", argv[1]);
+    return 1;
+  }
+
+  index_nodes(&g);
+  order = reverse_postorder(&g, &length);
+  idom = dominators(&g, order, length);
+
+  /* Children come after their dominators in reverse postorder,
+     so going backwards adds up each subtree before its root. */
+  for (i = 0; i < g.length; i++)
+    g.nodes[i].retained = g.nodes[i].size;
+  for (i = length - 1; i > 0; i--)
+    g.nodes[idom[order[i]]].retained += g.nodes[order[i]].retained;
+
+  print_report(&g, idom, argc > 2 ? strtoul(argv[2], NULL, 10) : 20);
+  return 0;
+}
+
+void* grow(void* array, size_t* capacity, size_t size) {
+  *capacity = *capacity == 0 ? 1024 : *capacity * 2;
+  array = realloc(array, *capacity * size);
+
+  if (array == NULL) {
+    fprintf(stderr, "Out of memory.\n");
+    exit(1);
+  }
+  return array;
+}
+
+/* Reads a space-separated token into 'token'.
+   Returns the character that ended it: ' ', '\n', or EOF. */
+int read_token(FILE* file, char* token) {
+  int length = 0;
+  int c;
+
+  while ((c = getc(file)) != EOF && c != ' ' && c != '\n') {
+    if (length < TOKEN_LENGTH - 1)
+      token[length++] = c;
+  }
+  token[length] = '\0';
+  return c;
+}
+
+void read_graph(FILE* file, graph* g) {
+  char token[TOKEN_LENGTH];
+  int end;
+
+  while ((end = read_token(file, token)) != EOF) {
+    node* n;
+
+    if (g->length == g->capacity)
+      g->nodes = grow(g->nodes, &g->capacity, sizeof(node));
+    n = g->nodes + g->length++;
+
+    n->address = strtoul(token, NULL, 16);
+    read_token(file, token);
+    n->type = type_index(g, token);
+    end = read_token(file, token);
+    n->size = strtoul(token, NULL, 10);
+    n->first_edge = g->edges_length;
+    n->edges = 0;
+
+    while (end == ' ') {
+      end = read_token(file, token);
+      if (g->edges_length == g->edges_capacity)
+        g->edges = grow(g->edges, &g->edges_capacity, sizeof(unsigned long));
+      g->edges[g->edges_length++] = strtoul(token, NULL, 16);
+      n->edges++;
+    }
+  }
+}
+
+int type_index(graph* g, const char* name) {
+  int i;
+
+  for (i = 0; i < g->types_length; i++) {
+    if (strcmp(g->types[i], name) == 0)
+      return i;
+  }
+
+  if (g->types_length == MAX_TYPES) {
+    fprintf(stderr, "Too many types.\n");
+    exit(1);
+  }
+  strcpy(g->types[g->types_length], name);
+  return g->types_length++;
+}
+
+/* Builds the address table,
+   then turns each edge into the index of the node it points to,
+   or UNDEFINED if there's no such node. */
+void index_nodes(graph* g) {
+  size_t i;
+
+  for (g->table_capacity = 1; g->table_capacity < g->length * 2;)
+    g->table_capacity *= 2;
+  g->table = malloc(g->table_capacity * sizeof(size_t));
+  for (i = 0; i < g->table_capacity; i++)
+    g->table[i] = UNDEFINED;
+
+  for (i = 0; i < g->length; i++) {
+    size_t slot = (g->nodes[i].address >> 4) & (g->table_capacity - 1);
+
+    while (g->table[slot] != UNDEFINED)
+      slot = (slot + 1) & (g->table_capacity - 1);
+    g->table[slot] = i;
+  }
+
+  for (i = 0; i < g->edges_length; i++)
+    g->edges[i] = find_node(g, g->edges[i]);
+}
+
+size_t find_node(graph* g, unsigned long address) {
+  size_t slot = (address >> 4) & (g->table_capacity - 1);
+
+  /* The roots' address is 0, and nothing refers to them. */
+  if (address == 0)
+    return UNDEFINED;
+
+  for (; g->table[slot] != UNDEFINED;
+       slot = (slot + 1) & (g->table_capacity - 1)) {
+    if (g->nodes[g->table[slot]].address == address)
+      return g->table[slot];
+  }
+  return UNDEFINED;
+}
+
+/* Returns the nodes reachable from the roots in reverse postorder,
+   and sets 'length' to how many there are.
+   The search uses an explicit stack, since the heap can be deep. */
+size_t* reverse_postorder(graph* g, size_t* length) {
+  size_t* order = malloc(g->length * sizeof(size_t));
+  size_t* stack = malloc(g->length * sizeof(size_t));
+  size_t* next_edge = calloc(g->length, sizeof(size_t));
+  char* seen = calloc(g->length, 1);
+  size_t done = g->length;
+  size_t top = 0;
+
+  stack[top++] = 0;
+  seen[0] = 1;
+
+  while (top > 0) {
+    size_t n = stack[top - 1];
+
+    if (next_edge[n] < g->nodes[n].edges) {
+      size_t child = g->edges[g->nodes[n].first_edge + next_edge[n]++];
+
+      if (child != UNDEFINED && !seen[child]) {
+        seen[child] = 1;
+        stack[top++] = child;
+      }
+      continue;
+    }
+
+    order[--done] = n;
+    top--;
+  }
+
+  *length = g->length - done;
+  memmove(order, order + done, *length * sizeof(size_t));
+
+  free(stack);
+  free(next_edge);
+  free(seen);
+  return order;
+}
+
+/* Returns each node's immediate dominator, indexed by node.
+   Unreachable nodes are left UNDEFINED. */
+size_t* dominators(graph* g, size_t* order, size_t length) {
+  size_t* idom = malloc(g->length * sizeof(size_t));
+  size_t* rank = malloc(g->length * sizeof(size_t));
+  size_t* pred_first = calloc(g->length + 1, sizeof(size_t));
+  size_t* preds = malloc((g->edges_length + 1) * sizeof(size_t));
+  size_t i, j;
+  int changed = 1;
+
+  for (i = 0; i < g->length; i++) {
+    idom[i] = UNDEFINED;
+    rank[i] = UNDEFINED;
+  }
+  for (i = 0; i < length; i++)
+    rank[order[i]] = i;
+
+  /* Build the predecessor lists of the reachable nodes. */
+  for (i = 0; i < g->length; i++) {
+    if (rank[i] == UNDEFINED)
+      continue;
+    for (j = 0; j < g->nodes[i].edges; j++) {
+      size_t child = g->edges[g->nodes[i].first_edge + j];
+      if (child != UNDEFINED)
+        pred_first[child + 1]++;
+    }
+  }
+  for (i = 0; i < g->length; i++)
+    pred_first[i + 1] += pred_first[i];
+  for (i = 0; i < g->length; i++) {
+    if (rank[i] == UNDEFINED)
+      continue;
+    for (j = 0; j < g->nodes[i].edges; j++) {
+      size_t child = g->edges[g->nodes[i].first_edge + j];
+      if (child != UNDEFINED)
+        preds[pred_first[child]++] = i;
+    }
+  }
+  /* Filling the lists moved each start up to the next one's. */
+  for (i = g->length; i > 0; i--)
+    pred_first[i] = pred_first[i - 1];
+  pred_first[0] = 0;
+
+  idom[0] = 0;
+  while (changed) {
+    changed = 0;
+
+    for (i = 1; i < length; i++) {
+      size_t n = order[i];
+      size_t new_idom = UNDEFINED;
+
+      for (j = pred_first[n]; j < pred_first[n + 1]; j++) {
+        size_t pred = preds[j];
+
+        if (idom[pred] == UNDEFINED)
+          continue;
+        new_idom = new_idom == UNDEFINED ?
+          pred : intersect(idom, rank, pred, new_idom);
+      }
+
+      if (idom[n] != new_idom) {
+        idom[n] = new_idom;
+        changed = 1;
+      }
+    }
+  }
+
+  free(rank);
+  free(pred_first);
+  free(preds);
+  return idom;
+}
+
+size_t intersect(size_t* idom, size_t* rank, size_t a, size_t b) {
+  while (a != b) {
+    while (rank[a] > rank[b])
+      a = idom[a];
+    while (rank[b] > rank[a])
+      b = idom[b];
+  }
+  return a;
+}
+
+int by_retained(const void* a, const void* b) {
+  size_t ra = sort_graph->nodes[*(const size_t*)a].retained;
+  size_t rb = sort_graph->nodes[*(const size_t*)b].retained;
+
+  return ra < rb ? 1 : ra > rb ? -1 : 0;
+}
+
+void print_report(graph* g, size_t* idom, size_t count) {
+  size_t type_count[MAX_TYPES];
+  size_t type_size[MAX_TYPES];
+  size_t* sorted = malloc(g->length * sizeof(size_t));
+  size_t i;
+  int t;
+
+  memset(type_count, 0, sizeof(type_count));
+  memset(type_size, 0, sizeof(type_size));
+  for (i = 1; i < g->length; i++) {
+    type_count[g->nodes[i].type]++;
+    type_size[g->nodes[i].type] += g->nodes[i].size;
+  }
+
+  printf("%12s %10s  %s\n", "bytes", "objects", "type");
+  for (t = 0; t < g->types_length; t++) {
+    if (type_count[t] > 0)
+      printf("%12lu %10lu  %s\n", (unsigned long)type_size[t],
+             (unsigned long)type_count[t], g->types[t]);
+  }
+
+  for (i = 0; i < g->length - 1; i++)
+    sorted[i] = i + 1;
+  sort_graph = g;
+  qsort(sorted, g->length - 1, sizeof(size_t), by_retained);
+
+  printf("\n%12s %10s  %s\n", "retained", "size", "object <- dominators");
+  for (i = 0; count > 0 && i < g->length - 1; i++) {
+    node* n = g->nodes + sorted[i];
+    size_t dom = idom[sorted[i]];
+    int depth;
+
+    /* Unreachable. */
+    if (dom == UNDEFINED)
+      continue;
+    count--;
+
+    printf("%12lu %10lu  %s %lx", (unsigned long)n->retained,
+           (unsigned long)n->size, g->types[n->type], n->address);
+
+    for (depth = 0; dom != 0 && depth < CHAIN_LENGTH; depth++) {
+      printf(" <- %s %lx", g->types[g->nodes[dom].type],
+             g->nodes[dom].address);
+      dom = idom[dom];
+    }
+    printf(dom == 0 ? " <- roots\n" : " <- ...\n");
+  }
+
+  free(sorted);
+}
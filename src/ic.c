@@ -0,0 +1,191 @@
+#include "ic.h"
+#include "gc.h"
+#include "state.h"
+#include "prototype.h"
+
+static jz_val get_miss(JZ_STATE, jz_bytecode* code, jz_ic* ic,
+                       jz_obj* obj, jz_str* key);
+static jz_val* find_own(JZ_STATE, jz_bytecode* code, jz_ic* ic,
+                        jz_obj* obj, jz_str* key);
+static void add_slot_entry(JZ_STATE, jz_bytecode* code, jz_ic* ic, jz_str* key,
+                           jz_shape* shape, jz_obj* holder, int slot);
+static void add_cell_entry(JZ_STATE, jz_bytecode* code, jz_ic* ic, jz_str* key,
+                           jz_obj* obj, jz_obj_cell* cell);
+static jz_ic_entry* new_entry(JZ_STATE, jz_bytecode* code, jz_ic* ic,
+                              jz_str* key);
+
+/* Whether 'entry' says where 'key' is in the receiver 'obj' itself. */
+#define OWN_HIT(entry, obj, key)                                        \
+  ((entry)->key == (key) &&                                             \
+   ((obj)->shape != NULL ?                                              \
+    (entry)->shape == (obj)->shape && (entry)->holder == NULL :         \
+    (entry)->shape == NULL && (entry)->holder == (obj) &&               \
+    (entry)->loc.dict.table == (obj)->props.dict.table &&               \
+    (entry)->loc.dict.cell->key == (key)))
+
+/* Whether 'entry' says where 'key' is in the prototype of 'obj'.
+   The receiver's shape proves that it doesn't have 'key' itself,
+   and the prototype's shape proves that it's still in the same slot. */
+#define PROTO_HIT(entry, obj, key)                                      \
+  ((entry)->key == (key) && (entry)->holder != NULL &&                  \
+   (entry)->shape == (obj)->shape && (obj)->shape != NULL &&            \
+   (obj)->prototype != NULL &&                                          \
+   (obj)->prototype->obj == (entry)->holder &&                          \
+   (entry)->holder->shape == (entry)->holder_shape)
+
+jz_val jz_ic_get(JZ_STATE, jz_bytecode* code, jz_index index,
+                 jz_obj* obj, jz_str* key) {
+  jz_ic* ic = code->ics + index;
+  jz_ic_entry* entry = ic->entries;
+  jz_ic_entry* top = entry + ic->length;
+
+  for (; entry < top; entry++) {
+    if (OWN_HIT(entry, obj, key)) {
+      if (entry->shape == NULL) return entry->loc.dict.cell->value;
+      return JZ_OBJ_SLOT(obj, entry->loc.slot);
+    }
+
+    if (PROTO_HIT(entry, obj, key))
+      return JZ_OBJ_SLOT(entry->holder, entry->loc.slot);
+  }
+
+  /* Keys that aren't atoms are generally computed on the fly,
+     so the same pointer is unlikely to show up here again. */
+  if (!JZ_STR_IS_ATOM(key)) return jz_obj_get(jz, obj, key);
+
+  return get_miss(jz, code, ic, obj, key);
+}
+
+void jz_ic_put(JZ_STATE, jz_bytecode* code, jz_index index,
+               jz_obj* obj, jz_str* key, jz_val val) {
+  jz_ic* ic = code->ics + index;
+  jz_ic_entry* entry = ic->entries;
+  jz_ic_entry* top = entry + ic->length;
+  jz_val* place = NULL;
+
+  for (; entry < top; entry++) {
+    if (OWN_HIT(entry, obj, key)) {
+      if (entry->shape == NULL) place = &entry->loc.dict.cell->value;
+      else place = &JZ_OBJ_SLOT(obj, entry->loc.slot);
+      break;
+    }
+  }
+
+  /* Only stores to existing properties are cached.
+     Adding a property changes the object's shape,
+     so it's left to jz_obj_put. */
+  if (place == NULL && JZ_STR_IS_ATOM(key))
+    place = find_own(jz, code, ic, obj, key);
+  if (place == NULL) {
+    jz_obj_put(jz, obj, key, val);
+    return;
+  }
+
+  JZ_GC_WRITE_BARRIER_VAL(jz, obj, val);
+  *place = val;
+}
+
+void jz_ic_mark(JZ_STATE, jz_ic* ic) {
+  jz_ic_entry* entry = ic->entries;
+  jz_ic_entry* top = entry + ic->length;
+
+  for (; entry < top; entry++) {
+    jz_gc_mark_gray(jz, (jz_gc_header*)entry->key);
+    jz_gc_mark_gray(jz, (jz_gc_header*)entry->shape);
+    jz_gc_mark_gray(jz, (jz_gc_header*)entry->holder);
+    jz_gc_mark_gray(jz, (jz_gc_header*)entry->holder_shape);
+  }
+}
+
+/* Looks up 'key' the slow way and caches where it was found,
+   if it was in 'obj' or its immediate prototype. */
+jz_val get_miss(JZ_STATE, jz_bytecode* code, jz_ic* ic,
+                jz_obj* obj, jz_str* key) {
+  jz_val* place = find_own(jz, code, ic, obj, key);
+  jz_obj* proto;
+  int slot;
+
+  if (place != NULL) return *place;
+  if (obj->shape == NULL || obj->prototype == NULL)
+    return jz_obj_get(jz, obj, key);
+
+  proto = obj->prototype->obj;
+  if (proto->shape == NULL) return jz_obj_get(jz, obj, key);
+
+  slot = jz_shape_lookup(jz, proto->shape, key);
+  if (slot < 0) return jz_obj_get(jz, proto, key);
+
+  add_slot_entry(jz, code, ic, key, obj->shape, proto, slot);
+  return JZ_OBJ_SLOT(proto, slot);
+}
+
+/* Returns a pointer to the value of 'key' in 'obj' itself,
+   caching where it was found,
+   or NULL if 'obj' doesn't have that property. */
+jz_val* find_own(JZ_STATE, jz_bytecode* code, jz_ic* ic,
+                 jz_obj* obj, jz_str* key) {
+  if (obj->shape != NULL) {
+    int slot = jz_shape_lookup(jz, obj->shape, key);
+
+    if (slot < 0) return NULL;
+    add_slot_entry(jz, code, ic, key, obj->shape, NULL, slot);
+    return &JZ_OBJ_SLOT(obj, slot);
+  } else if (!JZ_OBJ_HAS_CELLS(obj)) {
+    jz_obj_cell* cell = jz_obj_find_cell(jz, obj, key);
+
+    if (cell == NULL) return NULL;
+    add_cell_entry(jz, code, ic, key, obj, cell);
+    return &cell->value;
+  }
+
+  /* Global cells are already cached by index in load_global. */
+  return NULL;
+}
+
+void add_slot_entry(JZ_STATE, jz_bytecode* code, jz_ic* ic, jz_str* key,
+                    jz_shape* shape, jz_obj* holder, int slot) {
+  jz_ic_entry* entry = new_entry(jz, code, ic, key);
+
+  if (entry == NULL) return;
+
+  entry->shape = shape;
+  entry->holder = holder;
+  entry->holder_shape = holder == NULL ? NULL : holder->shape;
+  entry->loc.slot = slot;
+
+  JZ_GC_WRITE_BARRIER(jz, code, shape);
+  JZ_GC_WRITE_BARRIER(jz, code, holder);
+  JZ_GC_WRITE_BARRIER(jz, code, entry->holder_shape);
+}
+
+void add_cell_entry(JZ_STATE, jz_bytecode* code, jz_ic* ic, jz_str* key,
+                    jz_obj* obj, jz_obj_cell* cell) {
+  jz_ic_entry* entry = new_entry(jz, code, ic, key);
+
+  if (entry == NULL) return;
+
+  entry->shape = NULL;
+  entry->holder = obj;
+  entry->holder_shape = NULL;
+  entry->loc.dict.table = obj->props.dict.table;
+  entry->loc.dict.cell = cell;
+
+  JZ_GC_WRITE_BARRIER(jz, code, obj);
+}
+
+/* Returns a fresh entry in 'ic' for 'key',
+   or NULL if the cache is full.
+   A full cache is left alone rather than evicting old entries,
+   since a site that sees that many kinds of objects
+   is unlikely to be helped much by caching. */
+jz_ic_entry* new_entry(JZ_STATE, jz_bytecode* code, jz_ic* ic, jz_str* key) {
+  jz_ic_entry* entry;
+
+  if (ic->length == JZ_IC_SIZE) return NULL;
+
+  entry = ic->entries + ic->length++;
+  entry->key = key;
+  JZ_GC_WRITE_BARRIER(jz, code, key);
+
+  return entry;
+}
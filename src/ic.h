@@ -0,0 +1,56 @@
+/* Inline caches.
+   Each instruction that looks up a property
+   has a cache of the last few places it found that property,
+   so that lookups on objects shaped like ones it's seen before
+   go straight to the right slot without hashing or comparing strings. */
+
+#ifndef JZ_IC_H
+#define JZ_IC_H
+
+#include "jazz.h"
+#include "compile.h"
+#include "object.h"
+
+/* The number of different receivers an inline cache remembers.
+   Once it's full, lookups at that instruction
+   just take the slow path. */
+#define JZ_IC_SIZE 4
+
+typedef struct {
+  jz_str* key;
+
+  /* The shape of the receiver,
+     or NULL if the receiver was in dictionary mode. */
+  jz_shape* shape;
+
+  /* The object the property was found in.
+     For shape-mode receivers, this is NULL if it was the receiver itself,
+     or the receiver's prototype, in which case holder_shape is its shape.
+     For dictionary-mode receivers, this is the receiver. */
+  jz_obj* holder;
+  jz_shape* holder_shape;
+
+  union {
+    unsigned int slot;
+    struct {
+      jz_obj_cell* table;
+      jz_obj_cell* cell;
+    } dict;
+  } loc;
+} jz_ic_entry;
+
+struct jz_ic {
+  jz_byte length;
+  jz_ic_entry entries[JZ_IC_SIZE];
+};
+
+/* Like jz_obj_get and jz_obj_put,
+   but use and update the cache 'ic' in 'code'. */
+jz_val jz_ic_get(JZ_STATE, jz_bytecode* code, jz_index ic,
+                 jz_obj* obj, jz_str* key);
+void jz_ic_put(JZ_STATE, jz_bytecode* code, jz_index ic,
+               jz_obj* obj, jz_str* key, jz_val val);
+
+void jz_ic_mark(JZ_STATE, jz_ic* ic);
+
+#endif
@@ -15,6 +15,8 @@ typedef struct jz_str jz_str;
 typedef struct jz_proto jz_proto;
 typedef struct jz_gc_header jz_gc_header;
 typedef struct jz_frame jz_frame;
+typedef struct jz_shape jz_shape;
+typedef struct jz_ic jz_ic;
 
 #define JZ_STATE jz_state* jz
 
@@ -0,0 +1,74 @@
+#include <string.h>
+struct hash_result { char* name; int token; };
+static const struct hash_result wordlist[] = {
+  {"true", TRUE_VAL},
+  {"false", FALSE_VAL},
+  {"null", NULL_VAL},
+  {"this", THIS},
+  {"return", RETURN},
+  {"var", VAR},
+  {"if", IF},
+  {"else", ELSE},
+  {"do", DO},
+  {"while", WHILE},
+  {"for", FOR},
+  {"switch", SWITCH},
+  {"case", CASE},
+  {"default", DEFAULT},
+  {"function", FUNCTION},
+  {"{", LCURLY},
+  {"}", RCURLY},
+  {"(", LPAREN},
+  {")", RPAREN},
+  {"[", LSQUARE},
+  {"]", RSQUARE},
+  {".", DOT},
+  {";", SEMICOLON},
+  {",", COMMA},
+  {"<", LESS_THAN},
+  {">", GREATER_THAN},
+  {">=", GT_EQ},
+  {"<=", LT_EQ},
+  {"==", EQ_EQ},
+  {"!=", NOT_EQ},
+  {"===", STRICT_EQ},
+  {"!==", NOT_STRICT_EQ},
+  {"+", PLUS},
+  {"-", MINUS},
+  {"*", TIMES},
+  {"%", MOD},
+  {"++", PLUS_PLUS},
+  {"--", MINUS_MINUS},
+  {"<<", LSHIFT},
+  {">>", RSHIFT},
+  {">>>", URSHIFT},
+  {"&", BW_AND},
+  {"|", BW_OR},
+  {"^", XOR},
+  {"!", NOT},
+  {"~", BW_NOT},
+  {"&&", AND},
+  {"||", OR},
+  {"?", QUESTION},
+  {":", COLON},
+  {"=", EQUALS},
+  {"+=", PLUS_EQ},
+  {"-=", MINUS_EQ},
+  {"*=", TIMES_EQ},
+  {"%=", MOD_EQ},
+  {"<<=", LSHIFT_EQ},
+  {">>=", RSHIFT_EQ},
+  {">>>=", URSHIFT_EQ},
+  {"&=", BW_AND_EQ},
+  {"|=", BW_OR_EQ},
+  {"^=", XOR_EQ},
+  {"/", DIV},
+  {"/=", DIV_EQ},
+};
+static const struct hash_result* in_word_set(register const char* str, register unsigned int len) {
+  unsigned int i;
+  for (i = 0; i < sizeof(wordlist)/sizeof(wordlist[0]); i++)
+    if (strlen(wordlist[i].name) == len && !strncmp(wordlist[i].name, str, len))
+      return &wordlist[i];
+  return 0;
+}
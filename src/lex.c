@@ -144,9 +144,12 @@ int try_decimal_literal(STATE, YYSTYPE* lex_val) {
       if (*exp) lex_val->num *= pow(10.0, atof(exp));
       res = NUMBER;
     } else {
-      lex_val->i = (*num) ? atoi(num) : 0;
-      if (lex_val->i == INT_MAX || lex_val->i == INT_MIN)
+      /* atoi doesn't detect overflow,
+         and on 64-bit machines it just truncates a long. */
+      long i = (*num) ? strtol(num, NULL, 10) : 0;
+      if (i >= INT_MAX || i <= INT_MIN)
         goto overflow_detected;
+      lex_val->i = i;
 
       if (*exp) {
         int exp_num = atoi(exp);
@@ -239,6 +242,7 @@ jz_bool try_string_literal(STATE, YYSTYPE* lex_val) {
     }
 
     lex_val->str->length = res - JZ_STR_PTR(lex_val->str);
+    lex_val->str = jz_str_intern(jz, lex_val->str);
     return jz_true;
   }
 }
@@ -314,7 +318,7 @@ int try_identifier(STATE, YYSTYPE* lex_val) {
 
   if (result) return result->token;
 
-  lex_val->str = jz_match;
+  lex_val->str = jz_str_intern(jz, jz_match);
   return IDENTIFIER;
 }
 
@@ -389,7 +393,7 @@ void jz_lex_init(JZ_STATE) {
   jz->lex.decimal_literal_re1  = create_re("\\A" DECIMAL_INTEGER_LITERAL_RE "(\\.[0-9]*)" EXPONENT_PART_RE "?");
   jz->lex.decimal_literal_re2  = create_re("\\A()(\\.[0-9]+)" EXPONENT_PART_RE "?");
   jz->lex.decimal_literal_re3  = create_re("\\A" DECIMAL_INTEGER_LITERAL_RE "()" EXPONENT_PART_RE "?");
-  jz->lex.string_literal_re    = create_re("\\A('|\")((?:[^\\1\\\\" LINE_TERMINATOR_CHARS "]|"
+  jz->lex.string_literal_re    = create_re("\\A('|\")((?:[^\\\\" LINE_TERMINATOR_CHARS "]|"
                                              "\\\\(?:[^1-9" LINE_TERMINATOR_CHARS "]))*?)\\1");
 }
 
@@ -6,8 +6,9 @@
 #include "gc.h"
 #include "state.h"
 #include "prototype.h"
+#include "cells.h"
 
-#define MASK(obj, hash) ((hash) & ((obj)->capacity - 1))
+#define MASK(obj, hash) ((hash) & ((obj)->props.dict.capacity - 1))
 
 /* Controls how large objects' hash tables are initially: 2 ** DEFAULT_ORDER. */
 #define DEFAULT_ORDER (3)
@@ -20,6 +21,19 @@
    its new capacity is old_capacity * (2 ** ORDER_INCREMENT) */
 #define ORDER_INCREMENT (2)
 
+/* The number of overflow slots allocated when an object first needs them.
+   The overflow array doubles in size each time it fills up. */
+#define MIN_OVERFLOW (4)
+
+static void add_slot(JZ_STATE, jz_obj* this, jz_shape* shape, jz_val val);
+static void to_dictionary(JZ_STATE, jz_obj* this);
+static void each_slot(JZ_STATE, jz_obj* this, jz_shape* shape,
+                      jz_obj_fn* fn, void* data);
+
+static void each_cell(JZ_STATE, jz_obj_fn* fn, void* data);
+
+static void dict_init(JZ_STATE, jz_obj* this);
+static void dict_put(JZ_STATE, jz_obj* this, jz_str* key, jz_val val);
 static jz_obj_cell* get_cell(JZ_STATE, jz_obj* this, jz_str* key, jz_bool removed);
 static void grow(JZ_STATE, jz_obj* this);
 
@@ -37,27 +51,65 @@ jz_obj* jz_obj_new(JZ_STATE) {
 jz_obj* jz_obj_new_bare(JZ_STATE) {
   jz_obj* this = (jz_obj*)jz_gc_malloc(jz, jz_t_obj, sizeof(jz_obj));
 
-  this->capacity = 1 << DEFAULT_ORDER;
-  this->order = DEFAULT_ORDER;
-  this->size = 0;
-  this->table = calloc(sizeof(jz_obj_cell), this->capacity);
+  this->shape = jz->root_shape;
+  this->props.slots.overflow = NULL;
   this->prototype = NULL;
   this->call = NULL;
 
   return this;
 }
 
+jz_obj* jz_obj_new_global(JZ_STATE) {
+  jz_obj* this = jz_inst(jz, "Object");
+
+  this->shape = NULL;
+  JZ_SET_BIT(this->gc.tag, JZ_OBJ_CELLS_BIT, jz_true);
+  jz_obj_put2(jz, this, "prototype", this->prototype->obj);
+
+  return this;
+}
+
 jz_val jz_obj_get(JZ_STATE, jz_obj* this, jz_str* key) {
-  jz_obj_cell* cell = get_cell(jz, this, key, jz_false);
+  /* Every property key is an atom,
+     so if there's no atom for this key, no object has it. */
+  key = jz_str_find_atom(jz, key);
+  if (key == NULL)
+    return JZ_UNDEFINED;
 
-  if (cell->key == JZ_OBJ_EMPTY_KEY) {
-    if (this->prototype != NULL)
-      return jz_obj_get(jz, this->prototype->obj, key);
-    else
-      return JZ_UNDEFINED;
+  if (this->shape != NULL) {
+    int slot = jz_shape_lookup(jz, this->shape, key);
+
+    if (slot >= 0)
+      return JZ_OBJ_SLOT(this, slot);
+  } else if (JZ_OBJ_HAS_CELLS(this)) {
+    int index = jz_cell_find(jz, key);
+
+    if (index >= 0 && JZ_CELL(jz, index) != JZ_HOLE)
+      return JZ_CELL(jz, index);
+  } else {
+    jz_obj_cell* cell = get_cell(jz, this, key, jz_false);
+
+    if (cell->key != JZ_OBJ_EMPTY_KEY)
+      return cell->value;
   }
 
-  return cell->value;
+  if (this->prototype != NULL)
+    return jz_obj_get(jz, this->prototype->obj, key);
+  else
+    return JZ_UNDEFINED;
+}
+
+jz_obj_cell* jz_obj_find_cell(JZ_STATE, jz_obj* this, jz_str* key) {
+  jz_obj_cell* cell;
+
+  key = jz_str_find_atom(jz, key);
+  if (key == NULL)
+    return NULL;
+
+  cell = get_cell(jz, this, key, jz_false);
+  if (cell->key == JZ_OBJ_EMPTY_KEY)
+    return NULL;
+  return cell;
 }
 
 void* jz_obj_get_ptr(JZ_STATE, jz_obj* this, jz_str* key) {
@@ -70,19 +122,36 @@ void* jz_obj_get_ptr(JZ_STATE, jz_obj* this, jz_str* key) {
 }
 
 void jz_obj_put(JZ_STATE, jz_obj* this, jz_str* key, jz_val val) {
-  jz_obj_cell* cell;
-
-  JZ_GC_WRITE_BARRIER(jz, this, key);
+  key = jz_str_intern(jz, key);
   JZ_GC_WRITE_BARRIER_VAL(jz, this, val);
 
-  this->size++;
-  if ((this->size * 100)/this->capacity > LOAD_CAPACITY)
-    grow(jz, this);
+  if (this->shape != NULL) {
+    int slot = jz_shape_lookup(jz, this->shape, key);
 
-  cell = get_cell(jz, this, key, jz_true);
+    if (slot >= 0) {
+      JZ_OBJ_SLOT(this, slot) = val;
+      return;
+    }
 
-  cell->value = val;
-  cell->key = key;
+    if (this->shape->size < JZ_SHAPE_MAX_SIZE) {
+      jz_shape* shape = jz_shape_add(jz, this->shape, key);
+
+      if (shape != NULL) {
+        add_slot(jz, this, shape, val);
+        return;
+      }
+    }
+
+    to_dictionary(jz, this);
+  } else if (JZ_OBJ_HAS_CELLS(this)) {
+    jz_index index = jz_cell_index(jz, key);
+
+    JZ_CELL_SET(jz, index, val);
+    return;
+  }
+
+  JZ_GC_WRITE_BARRIER(jz, this, key);
+  dict_put(jz, this, key, val);
 }
 
 void* jz_obj_remove_ptr(JZ_STATE, jz_obj* this, jz_str* key, jz_bool* found) {
@@ -95,7 +164,41 @@ void* jz_obj_remove_ptr(JZ_STATE, jz_obj* this, jz_str* key, jz_bool* found) {
 }
 
 jz_val jz_obj_remove(JZ_STATE, jz_obj* this, jz_str* key, jz_bool* found) {
-  jz_obj_cell* cell = get_cell(jz, this, key, jz_false);
+  jz_obj_cell* cell;
+
+  key = jz_str_find_atom(jz, key);
+  if (key == NULL) {
+    if (found != NULL)
+      *found = jz_false;
+
+    return JZ_UNDEFINED;
+  }
+
+  if (this->shape != NULL) {
+    /* Shapes can only add properties, not take them away. */
+    if (jz_shape_lookup(jz, this->shape, key) >= 0)
+      to_dictionary(jz, this);
+    else {
+      if (found != NULL)
+        *found = jz_false;
+
+      return JZ_UNDEFINED;
+    }
+  } else if (JZ_OBJ_HAS_CELLS(this)) {
+    int index = jz_cell_find(jz, key);
+    jz_val val = index >= 0 ? JZ_CELL(jz, index) : JZ_HOLE;
+
+    if (found != NULL)
+      *found = val != JZ_HOLE;
+    if (val == JZ_HOLE)
+      return JZ_UNDEFINED;
+
+    /* The cell stays put, since compiled code refers to it by index. */
+    JZ_CELL(jz, index) = JZ_HOLE;
+    return val;
+  }
+
+  cell = get_cell(jz, this, key, jz_false);
 
   if (cell->key != JZ_OBJ_EMPTY_KEY) {
     if (found != NULL)
@@ -112,8 +215,21 @@ jz_val jz_obj_remove(JZ_STATE, jz_obj* this, jz_str* key, jz_bool* found) {
 }
 
 void jz_obj_each(JZ_STATE, jz_obj* this, jz_obj_fn* fn, void* data) {
-  jz_obj_cell* cell = this->table;
-  jz_obj_cell* top = this->table + this->capacity;
+  jz_obj_cell* cell;
+  jz_obj_cell* top;
+
+  if (this->shape != NULL) {
+    each_slot(jz, this, this->shape, fn, data);
+    return;
+  }
+
+  if (JZ_OBJ_HAS_CELLS(this)) {
+    each_cell(jz, fn, data);
+    return;
+  }
+
+  cell = this->props.dict.table;
+  top = this->props.dict.table + this->props.dict.capacity;
 
   for (; cell < top; cell++) {
     if (cell->key != JZ_OBJ_EMPTY_KEY &&
@@ -122,6 +238,86 @@ void jz_obj_each(JZ_STATE, jz_obj* this, jz_obj_fn* fn, void* data) {
   }
 }
 
+/* Adds a new property to an object in shape mode,
+   moving it to 'shape', which is its shape with that property added. */
+void add_slot(JZ_STATE, jz_obj* this, jz_shape* shape, jz_val val) {
+  unsigned int slot = this->shape->size;
+
+  if (slot >= JZ_OBJ_INLINE_SLOTS) {
+    unsigned int used = slot - JZ_OBJ_INLINE_SLOTS;
+
+    if (used == 0)
+      this->props.slots.overflow = malloc(sizeof(jz_val) * MIN_OVERFLOW);
+    else if (used >= MIN_OVERFLOW && (used & (used - 1)) == 0)
+      this->props.slots.overflow =
+        realloc(this->props.slots.overflow, sizeof(jz_val) * used * 2);
+  }
+
+  this->shape = shape;
+  JZ_GC_WRITE_BARRIER(jz, this, this->shape);
+
+  JZ_OBJ_SLOT(this, slot) = val;
+}
+
+/* Moves an object's properties from its slots into a hash table. */
+void to_dictionary(JZ_STATE, jz_obj* this) {
+  jz_shape* shape = this->shape;
+  jz_val* values = malloc(sizeof(jz_val) * (shape->size + 1));
+  unsigned int i;
+
+  for (i = 0; i < shape->size; i++)
+    values[i] = JZ_OBJ_SLOT(this, i);
+  free(this->props.slots.overflow);
+
+  this->shape = NULL;
+  dict_init(jz, this);
+
+  /* Walking up the shape visits the properties from last added to first. */
+  for (; shape->key != NULL; shape = shape->parent)
+    dict_put(jz, this, shape->key, values[shape->size - 1]);
+
+  free(values);
+}
+
+/* Calls fn on each property in shape, from first added to last. */
+void each_slot(JZ_STATE, jz_obj* this, jz_shape* shape,
+               jz_obj_fn* fn, void* data) {
+  if (shape->key == NULL) return;
+
+  each_slot(jz, this, shape->parent, fn, data);
+  fn(jz, shape->key, JZ_OBJ_SLOT(this, shape->size - 1), data);
+}
+
+/* Calls fn on each defined global, in the order their cells were created. */
+void each_cell(JZ_STATE, jz_obj_fn* fn, void* data) {
+  size_t i;
+
+  for (i = 0; i < jz->cells.length; i++) {
+    if (JZ_CELL(jz, i) != JZ_HOLE)
+      fn(jz, JZ_CELL_NAME(jz, i), JZ_CELL(jz, i), data);
+  }
+}
+
+void dict_init(JZ_STATE, jz_obj* this) {
+  this->props.dict.capacity = 1 << DEFAULT_ORDER;
+  this->props.dict.order = DEFAULT_ORDER;
+  this->props.dict.size = 0;
+  this->props.dict.table =
+    calloc(sizeof(jz_obj_cell), this->props.dict.capacity);
+}
+
+void dict_put(JZ_STATE, jz_obj* this, jz_str* key, jz_val val) {
+  jz_obj_cell* cell;
+
+  this->props.dict.size++;
+  if ((this->props.dict.size * 100)/this->props.dict.capacity > LOAD_CAPACITY)
+    grow(jz, this);
+
+  cell = get_cell(jz, this, key, jz_true);
+
+  cell->value = val;
+  cell->key = key;
+}
 jz_obj_cell* get_cell(JZ_STATE, jz_obj* this,
                       jz_str* key, jz_bool removed) {
   jz_obj_cell* cell;
@@ -129,38 +325,36 @@ jz_obj_cell* get_cell(JZ_STATE, jz_obj* this,
   unsigned int hash = jz_str_hash(jz, key);
 
   hash = MASK(this, hash);
-  cell = this->table + hash;
+  cell = this->props.dict.table + hash;
 
   for (; cell->key != JZ_OBJ_EMPTY_KEY; cell++) {
     if (cell->key == JZ_OBJ_REMOVED_KEY) {
       if (removed)
         return cell;
-    } else {
-      if (jz_str_equal(jz, cell->key, key))
-        return cell;
-    }
+    } else if (cell->key == key)
+      return cell;
 
     /* Wrap around */
-    if (cell == this->table + this->capacity - 1)
-      cell = this->table;
+    if (cell == this->props.dict.table + this->props.dict.capacity - 1)
+      cell = this->props.dict.table;
   }
 
   return cell;
 }
 
 void grow(JZ_STATE, jz_obj* this) {
-  jz_obj_cell* old_table = this->table;
+  jz_obj_cell* old_table = this->props.dict.table;
   jz_obj_cell* old_table_iter = old_table;
-  jz_obj_cell* old_table_end = this->table + this->capacity;
+  jz_obj_cell* old_table_end = this->props.dict.table + this->props.dict.capacity;
 
-  this->order += ORDER_INCREMENT;
-  this->capacity = 1 << this->order;
-  this->table = calloc(sizeof(jz_obj_cell), this->capacity);
+  this->props.dict.order += ORDER_INCREMENT;
+  this->props.dict.capacity = 1 << this->props.dict.order;
+  this->props.dict.table = calloc(sizeof(jz_obj_cell), this->props.dict.capacity);
 
   for (; old_table_iter < old_table_end; old_table_iter++) {
     if (old_table_iter->key != JZ_OBJ_EMPTY_KEY &&
         old_table_iter->key != JZ_OBJ_REMOVED_KEY)
-      jz_obj_put(jz, this, old_table_iter->key, old_table_iter->value);
+      dict_put(jz, this, old_table_iter->key, old_table_iter->value);
   }
 
   free(old_table);
@@ -176,14 +370,17 @@ jz_val jz_obj_value_of(JZ_STATE, jz_obj* obj) {
   return obj;
 }
 
-void jz_obj_free(JZ_STATE, jz_obj* obj) {
-  free(obj->table);
-  obj->table = NULL;
+void jz_obj_finalize(JZ_STATE, jz_obj* obj) {
+  if (obj->shape != NULL) {
+    free(obj->props.slots.overflow);
+    obj->props.slots.overflow = NULL;
+  } else if (!JZ_OBJ_HAS_CELLS(obj)) {
+    free(obj->props.dict.table);
+    obj->props.dict.table = NULL;
+  }
 
   if (obj->prototype && obj->prototype->finalizer)
     obj->prototype->finalizer(jz, obj);
-
-  free(obj);
 }
 
 void jz_init_obj_proto(JZ_STATE) {
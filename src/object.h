@@ -6,24 +6,62 @@
 #include "value.h"
 #include "string.h"
 #include "function.h"
+#include "shape.h"
 
 typedef struct {
   jz_str* key; /* NULL when the cell is empty. */
   jz_val value;
 } jz_obj_cell;
 
+/* The number of property slots stored directly in each object.
+   Any more are stored in a separately-allocated overflow array. */
+#define JZ_OBJ_INLINE_SLOTS 4
+
 struct jz_obj {
   jz_gc_header gc;
   jz_proto* prototype;
   jz_fn* call;
   void* data;
-  /* TODO: uint32 */
-  unsigned int capacity; /* The number of cells in the table. */
-  jz_byte order; /* 1 << capacity */
-  unsigned int size; /* The number of active elements currently in the table. */
-  jz_obj_cell* table;
+
+  /* Objects start out in shape mode,
+     where this describes which property is stored in which slot
+     (see shape.h).
+     Removing a property, adding more than JZ_SHAPE_MAX_SIZE properties,
+     or adding one that would take a shape past JZ_SHAPE_MAX_TRANSITIONS
+     switches the object to dictionary mode,
+     where the properties are stored in a private hash table
+     and this is NULL.
+
+     The global object is in neither mode:
+     its properties are stored in the global cells (see cells.h),
+     JZ_OBJ_HAS_CELLS is true for it, and this is NULL. */
+  jz_shape* shape;
+
+  union {
+    struct {
+      jz_val inline_slots[JZ_OBJ_INLINE_SLOTS];
+      jz_val* overflow;
+    } slots;
+
+    struct {
+      /* TODO: uint32 */
+      unsigned int capacity; /* The number of cells in the table. */
+      jz_byte order; /* 1 << capacity */
+      unsigned int size; /* The number of active elements currently in the table. */
+      jz_obj_cell* table;
+    } dict;
+  } props;
 };
 
+#define JZ_OBJ_CELLS_BIT 2
+#define JZ_OBJ_HAS_CELLS(obj) JZ_BIT((obj)->gc.tag, JZ_OBJ_CELLS_BIT)
+
+/* The property in slot i of an object in shape mode. */
+#define JZ_OBJ_SLOT(obj, i)                                     \
+  (*((i) < JZ_OBJ_INLINE_SLOTS ?                                \
+     (obj)->props.slots.inline_slots + (i) :                    \
+     (obj)->props.slots.overflow + (i) - JZ_OBJ_INLINE_SLOTS))
+
 typedef void jz_obj_fn(JZ_STATE, jz_str* key, jz_val val, void* data);
 
 #define JZ_OBJ_EMPTY_KEY   ((jz_str*)0)
@@ -32,11 +70,21 @@ typedef void jz_obj_fn(JZ_STATE, jz_str* key, jz_val val, void* data);
 jz_obj* jz_obj_new(JZ_STATE);
 jz_obj* jz_obj_new_bare(JZ_STATE);
 
+/* Creates the global object, which stores its properties in cells.
+   There should only ever be one of these. */
+jz_obj* jz_obj_new_global(JZ_STATE);
+
 jz_val jz_obj_get(JZ_STATE, jz_obj* this, jz_str* key);
 void* jz_obj_get_ptr(JZ_STATE, jz_obj* this, jz_str* key);
 #define jz_obj_get2(jz, this, key)              \
   jz_obj_get(jz, this, jz_str_from_literal(jz, key))
 
+/* Returns the cell holding 'key' in an object in dictionary mode
+   (but not the global object),
+   or NULL if the object has no such property.
+   Doesn't look at the object's prototype. */
+jz_obj_cell* jz_obj_find_cell(JZ_STATE, jz_obj* this, jz_str* key);
+
 void jz_obj_put(JZ_STATE, jz_obj* this, jz_str* key, jz_val val);
 #define jz_obj_put_ptr(jz, this, key, val)              \
   jz_obj_put(jz, this, key, jz_wrap_void(jz, (val)))
@@ -53,7 +101,8 @@ void jz_obj_each(JZ_STATE, jz_obj* this, jz_obj_fn* fn, void* data);
 jz_val jz_obj_to_str(JZ_STATE, jz_obj* obj);
 jz_val jz_obj_value_of(JZ_STATE, jz_obj* obj);
 
-void jz_obj_free(JZ_STATE, jz_obj* obj);
+/* Frees the memory an object owns. The object itself belongs to the GC. */
+void jz_obj_finalize(JZ_STATE, jz_obj* obj);
 
 void jz_init_obj_proto(JZ_STATE);
 
@@ -8,29 +8,67 @@
 typedef jz_byte jz_opcode;
 typedef unsigned short int jz_index;
 
-/* When updating this, don't forget to update jz_oc_names in vm.c */
+/* When updating this, don't forget to update jz_oc_names
+   and dispatch_table in vm.c */
 typedef enum {
   /* Argument: ptrdiff_t */
   jz_oc_jump,
   jz_oc_jump_unless,
   jz_oc_jump_if,
 
+  /* Arguments: jz_index, jz_index, ptrdiff_t */
+  jz_oc_lt_locals_jump_unless,
+  jz_oc_lt_local_const_jump_unless,
+
+  /* Arguments: jz_index, jz_index, jz_index
+
+     Register forms of the binary operators below.
+     The first argument is the local to store the result in,
+     and the other two are the operands encoded as described for JZ_RK.
+     These must stay in the same order as the stack forms. */
+  jz_oc_bw_or_r,
+  jz_oc_xor_r,
+  jz_oc_bw_and_r,
+  jz_oc_equals_r,
+  jz_oc_strict_eq_r,
+  jz_oc_lt_r,
+  jz_oc_gt_r,
+  jz_oc_lt_eq_r,
+  jz_oc_gt_eq_r,
+  jz_oc_lshift_r,
+  jz_oc_rshift_r,
+  jz_oc_urshift_r,
+  jz_oc_add_r,
+  jz_oc_sub_r,
+  jz_oc_times_r,
+  jz_oc_div_r,
+  jz_oc_mod_r,
+
+  /* Arguments: jz_index, jz_index */
+  jz_oc_add_local_const,
+  jz_oc_move_r,
+
   /* Argument: jz_index */
+  jz_oc_load_global, /* The index of a global cell (see cells.h). */
   jz_oc_store_global,
   jz_oc_retrieve,
   jz_oc_store,
   jz_oc_closure_retrieve,
   jz_oc_closure_store,
-  jz_oc_load_global,
+  jz_oc_capture_retrieve, /* The index of one of the function's captures. */
   jz_oc_call,
+  jz_oc_tail_call, /* A call in a return statement. */
   jz_oc_push_literal,
   jz_oc_push_closure,
+  jz_oc_inc_local,
+  jz_oc_dec_local,
+  /* These take an inline cache index (see ic.h). */
+  jz_oc_index,
+  jz_oc_index_store,
 
   /* No argument */
   jz_oc_push_global,
   jz_oc_push_obj,
-  jz_oc_index,
-  jz_oc_index_store,
   jz_oc_pop,
   jz_oc_dup,
   jz_oc_dup2,
@@ -65,9 +103,31 @@ typedef enum {
 
 const char* jz_oc_names[jz_oc_last];
 
-#define JZ_OC_ARGSIZE(oc)                               \
-  ((oc) <= jz_oc_jump_if ? JZ_OCS_PTRDIFF :             \
-   ((oc) <= jz_oc_push_closure ? JZ_OCS_INDEX : 0))
+#define JZ_OC_ARGSIZE(oc)                                               \
+  ((oc) <= jz_oc_jump_if ? JZ_OCS_PTRDIFF :                             \
+   (oc) <= jz_oc_lt_local_const_jump_unless ?                           \
+   JZ_OCS_INDEX * 2 + JZ_OCS_PTRDIFF :                                  \
+   (oc) <= jz_oc_mod_r ? JZ_OCS_INDEX * 3 :                             \
+   (oc) <= jz_oc_move_r ? JZ_OCS_INDEX * 2 :                            \
+   (oc) <= jz_oc_index_store ? JZ_OCS_INDEX : 0)
+
+/* Whether or not oc is a jump.
+   The last argument of a jump is always the ptrdiff_t offset to jump by,
+   relative to the end of the instruction. */
+#define JZ_OC_IS_JUMP(oc) ((oc) <= jz_oc_lt_local_const_jump_unless)
+
+/* Whether or not oc is a binary operator with a register form,
+   and the register form of such an operator. */
+#define JZ_OC_HAS_REGISTER_FORM(oc) \
+  ((oc) >= jz_oc_bw_or && (oc) <= jz_oc_mod)
+#define JZ_OC_REGISTER_FORM(oc) ((oc) - jz_oc_bw_or + jz_oc_bw_or_r)
+
+/* Register operands are "RK" indices:
+   if the high bit is set, the rest is an index into the constants,
+   otherwise the whole thing is an index into the locals. */
+#define JZ_RK_CONST_BIT    0x8000
+#define JZ_RK_IS_CONST(rk) ((rk) & JZ_RK_CONST_BIT)
+#define JZ_RK_INDEX(rk)    ((rk) & ~JZ_RK_CONST_BIT)
 
 #define JZ_OCS_PTRDIFF (sizeof(ptrdiff_t)/sizeof(jz_opcode))
 #define JZ_OCS_INDEX   (sizeof(jz_index)/sizeof(jz_opcode))
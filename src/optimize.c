@@ -0,0 +1,299 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+
+#include "optimize.h"
+
+/* The longest sequence of opcodes that's fused into one. */
+#define MAX_PATTERN 4
+
+typedef struct {
+  const jz_opcode* code;
+  size_t length;
+  const jz_val* consts;
+
+  /* targets[i] is true if some jump lands on the opcode at index i.
+     Sequences can't be fused across these,
+     since the jump would end up in the middle of a superinstruction. */
+  jz_bool* targets;
+
+  /* The indices of the opcodes most recently matched by match(). */
+  size_t matched[MAX_PATTERN];
+
+  jz_opcode* out;
+  size_t out_length;
+} opt_state;
+
+#define STATE JZ_STATE, opt_state* state
+
+#define INSTR_LENGTH(op) (1 + JZ_OC_ARGSIZE(op))
+#define ARG(type, offset) (*(type*)(state->code + (offset) + 1))
+#define INDEX_ARG(n, i) ARG(jz_index, state->matched[n] + (i) * JZ_OCS_INDEX)
+
+#define EMIT_OPCODE(op) (state->out[state->out_length++] = (op))
+#define EMIT_ARG(arg) \
+  emit_multibyte_arg(jz, state, &(arg), sizeof(arg)/sizeof(jz_opcode))
+
+static void find_targets(STATE);
+static size_t jump_target(STATE, size_t offset);
+static jz_bool match(STATE, size_t offset, int count, ...);
+static size_t fuse(STATE, size_t offset);
+#if JZ_REGISTER_OPS
+static size_t lower(STATE, size_t offset);
+static jz_bool rk_operand(STATE, size_t offset, jz_bool first, jz_index* rk);
+#endif
+static jz_bool is_unit(JZ_STATE, jz_val val);
+static void emit_multibyte_arg(STATE, const void* data, size_t size);
+
+jz_opcode* jz_optimize(JZ_STATE, const jz_opcode* code, size_t* length,
+                       const jz_val* consts) {
+  opt_state state_struct;
+  opt_state* state = &state_struct;
+  /* new_offsets[i] is the index in the output
+     of the instruction that was at index i in the input. */
+  size_t* new_offsets = calloc(sizeof(size_t), *length + 1);
+  /* The output indices of each jump instruction,
+     paired with the input indices of their targets. */
+  size_t* jumps = calloc(sizeof(size_t), *length);
+  size_t* old_targets = calloc(sizeof(size_t), *length);
+  size_t jumps_length = 0;
+  size_t offset = 0;
+  size_t i;
+
+  state->code = code;
+  state->length = *length;
+  state->consts = consts;
+  state->targets = calloc(sizeof(jz_bool), *length + 1);
+  /* Fusing opcodes never makes the code longer. */
+  state->out = calloc(sizeof(jz_opcode), *length);
+  state->out_length = 0;
+
+  find_targets(jz, state);
+
+  while (offset < *length) {
+    size_t start = state->out_length;
+    size_t next = fuse(jz, state, offset);
+
+#if JZ_REGISTER_OPS
+    if (next == offset) next = lower(jz, state, offset);
+#endif
+
+    new_offsets[offset] = start;
+
+    if (next == offset) {
+      next = offset + INSTR_LENGTH(code[offset]);
+      memcpy(state->out + start, code + offset, next - offset);
+      state->out_length += next - offset;
+    }
+
+    if (JZ_OC_IS_JUMP(state->out[start])) {
+      /* Fused jumps always come from sequences that end in a jump. */
+      size_t last = offset;
+      while (last + INSTR_LENGTH(code[last]) < next)
+        last += INSTR_LENGTH(code[last]);
+
+      jumps[jumps_length] = start;
+      old_targets[jumps_length] = jump_target(jz, state, last);
+      jumps_length++;
+    }
+
+    offset = next;
+  }
+  new_offsets[*length] = state->out_length;
+
+  for (i = 0; i < jumps_length; i++) {
+    jz_opcode op = state->out[jumps[i]];
+    size_t end = jumps[i] + INSTR_LENGTH(op);
+
+    *(ptrdiff_t*)(state->out + end - JZ_OCS_PTRDIFF) =
+      new_offsets[old_targets[i]] - end;
+  }
+
+  *length = state->out_length;
+
+  free(new_offsets);
+  free(jumps);
+  free(old_targets);
+  free(state->targets);
+
+  return state->out;
+}
+
+void find_targets(STATE) {
+  size_t offset = 0;
+
+  while (offset < state->length) {
+    if (JZ_OC_IS_JUMP(state->code[offset]))
+      state->targets[jump_target(jz, state, offset)] = jz_true;
+    offset += INSTR_LENGTH(state->code[offset]);
+  }
+}
+
+/* Returns the index of the opcode that the jump at 'offset' lands on. */
+size_t jump_target(STATE, size_t offset) {
+  size_t end = offset + INSTR_LENGTH(state->code[offset]);
+  return end + *(ptrdiff_t*)(state->code + end - JZ_OCS_PTRDIFF);
+}
+
+/* Returns whether the 'count' instructions starting at 'offset'
+   have the opcodes given in the varargs list.
+   If so, their indices are stored in state->matched. */
+jz_bool match(STATE, size_t offset, int count, ...) {
+  jz_bool matched = jz_true;
+  va_list ops;
+  int i;
+
+  va_start(ops, count);
+  for (i = 0; i < count; i++) {
+    jz_opcode op = (jz_opcode)va_arg(ops, int);
+
+    if (offset >= state->length || state->code[offset] != op ||
+        (i != 0 && state->targets[offset])) {
+      matched = jz_false;
+      break;
+    }
+
+    state->matched[i] = offset;
+    offset += INSTR_LENGTH(op);
+  }
+  va_end(ops);
+
+  return matched;
+}
+
+/* Tries to replace the instructions starting at 'offset'
+   with a superinstruction.
+   Returns the index of the first instruction that wasn't replaced,
+   or 'offset' if nothing was. */
+size_t fuse(STATE, size_t offset) {
+  /* i++, i--, and i += x all compile to
+     "retrieve i; push_literal x; add/sub; store i". */
+  if ((match(jz, state, offset, 4, jz_oc_retrieve, jz_oc_push_literal,
+             jz_oc_add, jz_oc_store) ||
+       match(jz, state, offset, 4, jz_oc_retrieve, jz_oc_push_literal,
+             jz_oc_sub, jz_oc_store)) &&
+      INDEX_ARG(0, 0) == INDEX_ARG(3, 0)) {
+    jz_index local = INDEX_ARG(0, 0);
+    jz_index literal = INDEX_ARG(1, 0);
+    jz_bool unit = is_unit(jz, state->consts[literal]);
+
+    if (state->code[state->matched[2]] == jz_oc_add) {
+      if (unit) EMIT_OPCODE(jz_oc_inc_local);
+      else EMIT_OPCODE(jz_oc_add_local_const);
+    } else if (unit) EMIT_OPCODE(jz_oc_dec_local);
+    else return offset;
+
+    EMIT_ARG(local);
+    if (!unit) EMIT_ARG(literal);
+
+    return state->matched[3] + INSTR_LENGTH(jz_oc_store);
+  }
+
+  /* Loop conditions like "i < n" and "i < 10". */
+  if (match(jz, state, offset, 4, jz_oc_retrieve, jz_oc_retrieve,
+            jz_oc_lt, jz_oc_jump_unless) ||
+      match(jz, state, offset, 4, jz_oc_retrieve, jz_oc_push_literal,
+            jz_oc_lt, jz_oc_jump_unless)) {
+    jz_index left = INDEX_ARG(0, 0);
+    jz_index right = INDEX_ARG(1, 0);
+    /* This is filled in along with the other jumps. */
+    ptrdiff_t jump = 0;
+
+    if (state->code[state->matched[1]] == jz_oc_retrieve)
+      EMIT_OPCODE(jz_oc_lt_locals_jump_unless);
+    else EMIT_OPCODE(jz_oc_lt_local_const_jump_unless);
+
+    EMIT_ARG(left);
+    EMIT_ARG(right);
+    EMIT_ARG(jump);
+
+    return state->matched[3] + INSTR_LENGTH(jz_oc_jump_unless);
+  }
+
+  return offset;
+}
+
+#if JZ_REGISTER_OPS
+/* Tries to replace the instructions starting at 'offset'
+   with a single register operation (see JZ_RK in opcode.h),
+   which reads its operands from locals or constants
+   and stores its result in a local without touching the stack.
+
+   Returns the index of the first instruction that wasn't replaced,
+   or 'offset' if nothing was. */
+size_t lower(STATE, size_t offset) {
+  jz_index src1, src2;
+  size_t next;
+
+  if (!rk_operand(jz, state, offset, jz_true, &src1)) return offset;
+  next = offset + INSTR_LENGTH(state->code[offset]);
+
+  /* "a = b" and "var a = 1" */
+  if (match(jz, state, next, 1, jz_oc_store) && !state->targets[next]) {
+    jz_index dst = INDEX_ARG(0, 0);
+
+    EMIT_OPCODE(jz_oc_move_r);
+    EMIT_ARG(dst);
+    EMIT_ARG(src1);
+
+    return next + INSTR_LENGTH(jz_oc_store);
+  }
+
+  /* "a = b + c", "a += b", and so forth */
+  if (rk_operand(jz, state, next, jz_false, &src2)) {
+    jz_opcode op;
+    jz_index dst;
+
+    next += INSTR_LENGTH(state->code[next]);
+    if (next >= state->length || state->targets[next]) return offset;
+
+    op = state->code[next];
+    if (!JZ_OC_HAS_REGISTER_FORM(op)) return offset;
+    next += INSTR_LENGTH(op);
+
+    if (!match(jz, state, next, 1, jz_oc_store) || state->targets[next])
+      return offset;
+    dst = INDEX_ARG(0, 0);
+
+    EMIT_OPCODE(JZ_OC_REGISTER_FORM(op));
+    EMIT_ARG(dst);
+    EMIT_ARG(src1);
+    EMIT_ARG(src2);
+
+    return next + INSTR_LENGTH(jz_oc_store);
+  }
+
+  return offset;
+}
+
+/* If the instruction at 'offset' just pushes a local or a constant,
+   sets 'rk' to the register operand for that value and returns true.
+   Unless this is the 'first' instruction in a sequence,
+   it also mustn't be a jump target. */
+jz_bool rk_operand(STATE, size_t offset, jz_bool first, jz_index* rk) {
+  jz_opcode op;
+  jz_index index;
+
+  if (offset >= state->length || (!first && state->targets[offset]))
+    return jz_false;
+
+  op = state->code[offset];
+  if (op != jz_oc_retrieve && op != jz_oc_push_literal) return jz_false;
+
+  index = ARG(jz_index, offset);
+  if (JZ_RK_IS_CONST(index)) return jz_false;
+
+  *rk = op == jz_oc_push_literal ? index | JZ_RK_CONST_BIT : index;
+  return jz_true;
+}
+#endif
+
+jz_bool is_unit(JZ_STATE, jz_val val) {
+  return JZ_IS_NUM(val) && jz_to_num(jz, val) == 1;
+}
+
+void emit_multibyte_arg(STATE, const void* data, size_t size) {
+  memcpy(state->out + state->out_length, data, size);
+  state->out_length += size;
+}
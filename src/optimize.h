@@ -0,0 +1,21 @@
+/* The Jazz bytecode optimizer.
+   Rewrites common sequences of opcodes emitted by the compiler (see compile.h)
+   into single "superinstructions" (see opcode.h)
+   that do the same work with one dispatch. */
+
+#ifndef JZ_OPTIMIZE_H
+#define JZ_OPTIMIZE_H
+
+#include "jazz.h"
+#include "compile.h"
+
+/* Optimizes 'code', which is 'length' opcodes long
+   and refers to the constants in 'consts'.
+
+   Returns a newly allocated array of opcodes,
+   and sets 'length' to the length of that array.
+   'code' itself is left untouched. */
+jz_opcode* jz_optimize(JZ_STATE, const jz_opcode* code, size_t* length,
+                       const jz_val* consts);
+
+#endif
@@ -138,10 +138,10 @@ var_decl_list: var_decl { $$ = CONS($1, NULL); }
   | var_decl_list COMMA var_decl { $$ = CONS($3, $1); }
 
 var_decl: IDENTIFIER {
-  $$ = jz_list(jz, 2, jz_str_deep_dup(jz, $1), NULL);
+  $$ = jz_list(jz, 2, $1, NULL);
  }
   | IDENTIFIER EQUALS assign_expr {
-    $$ = jz_list(jz, 2, jz_str_deep_dup(jz, $1), $3);
+    $$ = jz_list(jz, 2, $1, $3);
  }
 
 expr_statement: stmt_expr SEMICOLON { $$ = CONS(jz_enum_new(jz, jz_parse_expr), $1); }
@@ -379,8 +379,8 @@ function_expr: FUNCTION params LCURLY source_elements RCURLY {
 params: LPAREN RPAREN { $$ = NULL; }
   | LPAREN param_list RPAREN { $$ = jz_list_reverse(jz, $2); }
 
-param_list: IDENTIFIER { $$ = CONS(jz_str_deep_dup(jz, $1), NULL); }
-  | param_list COMMA IDENTIFIER { $$ = CONS(jz_str_deep_dup(jz, $3), $1); }
+param_list: IDENTIFIER { $$ = CONS($1, NULL); }
+  | param_list COMMA IDENTIFIER { $$ = CONS($3, $1); }
 
 primary_expr: stmt_primary_expr | object_literal
 stmt_primary_expr: identifier | literal
@@ -388,7 +388,7 @@ stmt_primary_expr: identifier | literal
   | LPAREN expr RPAREN { $$ = $2; }
 
 identifier: IDENTIFIER {
-  $$ = jz_enum_wrap(jz, jz_parse_identifier, jz_str_deep_dup(jz, $1));
+  $$ = jz_enum_wrap(jz, jz_parse_identifier, $1);
  }
 
 literal: literal_tval { $$ = jz_enum_wrap(jz, jz_parse_literal, $1); }
@@ -0,0 +1,84 @@
+#include "shape.h"
+#include "state.h"
+
+static jz_shape* shape_new(JZ_STATE, jz_shape* parent, jz_str* key);
+
+jz_shape* jz_shape_new_root(JZ_STATE) {
+  return shape_new(jz, NULL, NULL);
+}
+
+jz_shape* jz_shape_add(JZ_STATE, jz_shape* this, jz_str* key) {
+  jz_shape** link = &this->children;
+  jz_shape* child;
+
+  while ((child = *link) != NULL) {
+    /* While sweeping, black shapes are garbage that hasn't been swept yet.
+       They can't be handed out again, so they're unlinked now. */
+    if (jz_gc_sweeping(jz) && jz_gc_is_black(jz, child)) {
+      *link = child->sibling;
+      child->parent = NULL;
+      this->transitions--;
+      continue;
+    }
+
+    if (child->key == key)
+      return child;
+    link = &child->sibling;
+  }
+
+  if (this->transitions >= JZ_SHAPE_MAX_TRANSITIONS)
+    return NULL;
+
+  child = shape_new(jz, this, key);
+  child->sibling = this->children;
+  this->children = child;
+  this->transitions++;
+
+  return child;
+}
+
+int jz_shape_lookup(JZ_STATE, jz_shape* this, jz_str* key) {
+  for (; this->key != NULL; this = this->parent) {
+    if (this->key == key)
+      return this->size - 1;
+  }
+
+  return -1;
+}
+
+void jz_shape_finalize(JZ_STATE, jz_shape* this) {
+  jz_shape* child;
+
+  /* Whichever of a parent and child is finalized first
+     clears the other's reference to it,
+     so neither touches the other once it's been freed. */
+  if (this->parent != NULL) {
+    jz_shape** link = &this->parent->children;
+
+    while (*link != this)
+      link = &(*link)->sibling;
+    *link = this->sibling;
+    this->parent->transitions--;
+  }
+
+  for (child = this->children; child != NULL; child = child->sibling)
+    child->parent = NULL;
+}
+
+jz_shape* shape_new(JZ_STATE, jz_shape* parent, jz_str* key) {
+  jz_shape* this = (jz_shape*)jz_gc_malloc(jz, jz_t_shape, sizeof(jz_shape));
+
+  this->parent = parent;
+  this->key = key;
+  this->size = parent == NULL ? 0 : parent->size + 1;
+  this->children = NULL;
+  this->sibling = NULL;
+  this->transitions = 0;
+
+  /* Shapes made while marking are black without being blackened,
+     so the parent and key have to be grayed here. */
+  JZ_GC_WRITE_BARRIER(jz, this, parent);
+  JZ_GC_WRITE_BARRIER(jz, this, key);
+
+  return this;
+}
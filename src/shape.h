@@ -0,0 +1,65 @@
+/* Shapes (also known as hidden classes)
+   describe where an object's properties are stored.
+
+   A shape maps each property name to a slot index in the object.
+   Objects that had the same properties added in the same order
+   share the same shape,
+   so the mapping is stored once rather than per object.
+
+   Shapes form a tree rooted at jz->root_shape.
+   Each shape is its parent with one more property added,
+   and adding a property to an object moves it to a child of its shape,
+   creating that child if no other object has made the same transition.
+
+   A shape keeps its parent alive, but not its children:
+   a child that no object or inline cache refers to is collected,
+   and unlinks itself from its parent when it's finalized. */
+
+#ifndef JZ_SHAPE_H
+#define JZ_SHAPE_H
+
+#include "jazz.h"
+#include "gc.h"
+#include "string.h"
+
+struct jz_shape {
+  jz_gc_header gc;
+  jz_shape* parent; /* NULL for the root shape. */
+  jz_str* key; /* The property added on top of parent, or NULL for the root. */
+  unsigned int size; /* The number of properties. key's slot is size - 1. */
+
+  /* The shapes that this shape transitions to,
+     as a linked list through their sibling pointers.
+     These are weak references; see jz_shape_finalize. */
+  jz_shape* children;
+  jz_shape* sibling;
+  unsigned int transitions; /* The length of children. */
+};
+
+/* The number of properties an object can have
+   before it switches from a shape to a private hash table
+   (see jz_obj in object.h). */
+#define JZ_SHAPE_MAX_SIZE 32
+
+/* The number of children a shape can have.
+   Objects that would need another one switch to private hash tables too,
+   so that scripts using many different computed keys
+   don't make transitions slow to look up. */
+#define JZ_SHAPE_MAX_TRANSITIONS 64
+
+jz_shape* jz_shape_new_root(JZ_STATE);
+
+/* Keys are compared by identity, so they must be atoms (see string.h). */
+
+/* Returns the shape for this shape's properties with key added at the end,
+   or NULL if that would take more than JZ_SHAPE_MAX_TRANSITIONS. */
+jz_shape* jz_shape_add(JZ_STATE, jz_shape* this, jz_str* key);
+
+/* Returns the slot in which key is stored, or -1 if it isn't there. */
+int jz_shape_lookup(JZ_STATE, jz_shape* this, jz_str* key);
+
+/* Unlinks a dead shape from its parent and its children,
+   whichever of those are still around. */
+void jz_shape_finalize(JZ_STATE, jz_shape* this);
+
+#endif
@@ -1,31 +1,98 @@
+/* For MAP_ANONYMOUS and sigaction. */
+#define _DEFAULT_SOURCE
+
 #include <stdlib.h>
 #include <stdio.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
 
 #include "state.h"
 #include "lex.h"
 #include "object.h"
 #include "function.h"
+#include "shape.h"
+#include "cells.h"
 
 static void init_prototypes(JZ_STATE);
 static void init_global_object(JZ_STATE);
+static void init_stack(JZ_STATE);
+static void on_segv(int sig, siginfo_t* info, void* context);
+
+/* The Jazz stack is reserved all at once,
+   but pages are only given memory as the stack grows into them,
+   so it can be far bigger than any script is likely to need.
+   It's followed by a guard region that can't be touched,
+   so running off the end of the operand stack faults
+   rather than needing a check after every opcode.
+   Frames are checked as they're pushed (see jz_frame_new),
+   since one with enough locals could skip right over the guard. */
+#define STACK_SIZE (1 << 26)
+#define STACK_GUARD_SIZE (1 << 16)
 
-#define STACK_SIZE (1 << 18)
+/* Every state, for on_segv to check the guards of. */
+static jz_state* states = NULL;
 
 jz_state* jz_init() {
   jz_state* state = malloc(sizeof(jz_state));
 
-  state->stack = calloc(sizeof(jz_byte), STACK_SIZE);
-  state->stack_bottom = state->stack;
+  init_stack(state);
   state->current_frame = NULL;
 
   jz_gc_init(state);
+  jz_str_init_atoms(state);
   jz_lex_init(state);
+  state->root_shape = jz_shape_new_root(state);
+  jz_cells_init(state);
   init_prototypes(state);
   init_global_object(state);
 
   return state;
 }
 
+void init_stack(JZ_STATE) {
+  struct sigaction action;
+  void* stack = mmap(NULL, STACK_SIZE + STACK_GUARD_SIZE,
+                     PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+  if (stack == MAP_FAILED ||
+      mprotect((jz_byte*)stack + STACK_SIZE, STACK_GUARD_SIZE, PROT_NONE)) {
+    perror("Couldn't allocate the stack");
+    exit(1);
+  }
+
+  jz->stack = stack;
+  jz->stack_bottom = stack;
+
+  jz->next_state = states;
+  states = jz;
+
+  action.sa_sigaction = on_segv;
+  action.sa_flags = SA_SIGINFO;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGSEGV, &action, NULL);
+}
+
+void on_segv(int sig, siginfo_t* info, void* context) {
+  static const char message[] = "Stack overflow\n";
+  jz_byte* addr = info->si_addr;
+  jz_state* jz;
+
+  for (jz = states; jz != NULL; jz = jz->next_state) {
+    jz_byte* guard = jz->stack_bottom + STACK_SIZE;
+
+    if (addr >= guard && addr < guard + STACK_GUARD_SIZE) {
+      write(STDERR_FILENO, message, sizeof(message) - 1);
+      _exit(1);
+    }
+  }
+
+  /* Some other fault.
+     Returning retries the access, which then crashes as usual. */
+  signal(SIGSEGV, SIG_DFL);
+}
+
 void init_prototypes(JZ_STATE) {
   jz->prototypes = jz_obj_new_bare(jz);
   jz_init_obj_proto(jz);
@@ -35,7 +102,7 @@ void init_prototypes(JZ_STATE) {
 /* TODO: Free the global object
    TODO: Modify global object's [[Get]] so that it throws ReferenceErrors */
 void init_global_object(JZ_STATE) {
-  jz->global_obj = jz_obj_new(jz);
+  jz->global_obj = jz_obj_new_global(jz);
   jz_obj_put2(jz, jz->global_obj, "NaN", jz_wrap_num(jz, JZ_NAN));
   jz_obj_put2(jz, jz->global_obj, "Infinity", jz_wrap_num(jz, JZ_INF));
 
@@ -44,24 +111,30 @@ void init_global_object(JZ_STATE) {
   jz_obj_put2(jz, jz->global_obj, "undefined", JZ_UNDEFINED);
 }
 
-void jz_check_overflow(JZ_STATE, jz_byte* stack) {
-  if (stack == NULL)
-    stack = jz->stack;
-
-  if (stack - jz->stack_bottom >= STACK_SIZE) {
+void jz_check_overflow(JZ_STATE) {
+  if (jz->stack - jz->stack_bottom >= STACK_SIZE) {
     fprintf(stderr, "Stack overflow\n");
     exit(1);
   }
 }
 
 void jz_free_state(JZ_STATE) {
-  free(jz->stack_bottom);
+  jz_state** state = &states;
+
+  while (*state != jz)
+    state = &(*state)->next_state;
+  *state = jz->next_state;
+
+  munmap(jz->stack_bottom, STACK_SIZE + STACK_GUARD_SIZE);
   jz_lex_free(jz);
   jz->stack = NULL;
   jz->stack_bottom = NULL;
   jz->current_frame = NULL;
   jz->global_obj = NULL;
   jz->prototypes = NULL;
+  jz_cells_free(jz);
   jz_gc_cycle(jz);
+  jz_gc_free(jz);
+  jz_str_free_atoms(jz);
   free(jz);
 }
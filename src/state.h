@@ -10,20 +10,80 @@
 struct jz_state {
   jz_byte* stack;
   jz_byte* stack_bottom;
+  jz_state* next_state; /* See on_segv in state.c. */
   jz_frame* current_frame;
   jz_obj* prototypes;
   jz_obj* global_obj;
+  jz_shape* root_shape; /* The shape of objects with no properties. */
+  struct {
+    jz_val* values;
+    jz_str** names;
+    jz_obj* indices; /* Maps names to indices. */
+    size_t length;
+    size_t capacity;
+  } cells; /* See cells.h. */
+  struct {
+    jz_str** table; /* An open-addressed hash set. */
+    size_t capacity; /* Always a power of two. */
+    size_t size; /* The number of atoms in the table. */
+    size_t removed; /* The number of slots left behind by removed atoms. */
+  } atoms; /* See jz_str_intern. */
   struct {
     jz_byte state;
     jz_byte speed;
     jz_byte pause;
     size_t allocated;
     size_t threshold;
+    size_t debt; /* See jz_gc_safepoint. */
     jz_bool black_bit;
-    jz_gc_header* all_objs;
-    jz_gc_node* gray_stack;
-    jz_gc_header* prev_sweep_obj;
-    jz_gc_header* next_sweep_obj;
+    jz_gc_size_class classes[JZ_GC_SIZE_CLASSES];
+    jz_gc_large* large_objs;
+
+    /* The young objects. */
+    struct {
+      jz_gc_young* objs;
+      size_t length;
+      size_t capacity;
+      size_t bytes;
+    } nursery;
+
+    /* Old objects and closure variables that might refer to young objects. */
+    struct {
+      jz_gc_header** objs;
+      size_t length;
+      size_t capacity;
+    } remembered;
+    struct {
+      jz_val** slots;
+      size_t length;
+      size_t capacity;
+    } remembered_slots;
+
+    struct {
+      jz_gc_header** objs;
+      size_t length;
+      size_t capacity;
+      /* Whether a black object had to be left off the stack.
+         See rescan_heap in gc.c. */
+      jz_bool overflowed;
+    } gray_stack;
+
+    /* Where the sweeper will pick up from.
+       See also jz_gc_size_class. */
+    int sweep_class;
+    jz_gc_large* sweep_large;
+    jz_bool lazy_sweep;
+    jz_bool background_sweep;
+    /* The background sweep in progress, if any. */
+    jz_gc_sweeper* sweeper;
+
+    jz_gc_stats stats; /* Only the counters; see jz_gc_get_stats. */
+    jz_bool trace;
+    FILE* snapshot; /* Only set while jz_gc_snapshot is running. */
+
+    /* Only set in the copies of the state
+       that parallel marking threads work with. */
+    jz_gc_worker* worker;
   } gc;
   struct {
     URegularExpression* identifier_re;
@@ -42,8 +102,10 @@ struct jz_state {
 
 jz_state* jz_init();
 
-/* If stack is NULL, checks the global stack pointer */
-void jz_check_overflow(JZ_STATE, jz_byte* stack);
+/* Exits if jz->stack has run past the end of the stack.
+   The operand stack is covered by a guard region instead
+   (see state.c). */
+void jz_check_overflow(JZ_STATE);
 
 void jz_free_state(JZ_STATE);
 
@@ -13,11 +13,37 @@
 #define SET_EXT(str) JZ_SET_BIT(JZ_GC_TAG(str), JZ_STR_EXT_BIT, 1)
 #define SET_INT(str) JZ_SET_BIT(JZ_GC_TAG(str), JZ_STR_EXT_BIT, 0)
 
+/* A background sweep may be reading the tag at the same time;
+   see jz_gc_set_background_sweep. */
+#if JZ_GC_THREADS > 1
+#define SET_HASHED(str) \
+  __sync_fetch_and_or(&JZ_GC_TAG(str), JZ_BITMASK(JZ_STR_HASHED_BIT))
+#else
 #define SET_HASHED(str) JZ_SET_BIT(JZ_GC_TAG(str), JZ_STR_HASHED_BIT, 1)
+#endif
+
+/* The smallest the atom table gets.
+   Once atoms and removed slots fill half of it,
+   it's rebuilt with room for four times as many atoms as are left,
+   so it shrinks again after a burst of short-lived keys. */
+#define MIN_ATOMS (256)
+#define REMOVED_ATOM ((jz_str*)1)
+
+/* Literals this long or shorter are looked up in the atom table
+   without allocating a string first. */
+#define ATOM_BUFFER_LENGTH (64)
+
+/* During sweeping, atoms that weren't marked are about to be freed,
+   so they mustn't be handed out again. */
+#define ATOM_IS_DEAD(jz, atom)                          \
+  (jz_gc_sweeping(jz) && jz_gc_is_black(jz, atom))
 
 static jz_bool is_whitespace_char(UChar c);
 static jz_str* str_new(JZ_STATE, int start, int length);
 static jz_str_value* val_alloc(JZ_STATE, int length);
+static jz_str** find_atom(JZ_STATE, jz_str* str);
+static void add_atom(JZ_STATE, jz_str* atom);
+static void resize_atoms(JZ_STATE);
 
 jz_bool is_whitespace_char(UChar c) {
   return u_isblank(c) || (c) == 0xA0 || (c) == '\f' || (c) == '\v' ||
@@ -89,6 +115,7 @@ jz_str* jz_str_dup(JZ_STATE, const jz_str* this) {
   JZ_SET_BIT(JZ_GC_TAG(to_ret), JZ_STR_HASHED_BIT, JZ_STR_IS_HASHED(this));
   to_ret->start = this->start;
   to_ret->length = this->length;
+  to_ret->hash = this->hash;
   to_ret->value = this->value;
   return to_ret;
 }
@@ -145,6 +172,8 @@ jz_str* jz_str_concat(JZ_STATE, const jz_str* s1, const jz_str* s2) {
 }
 
 jz_bool jz_str_equal(JZ_STATE, const jz_str* s1, const jz_str* s2) {
+  if (s1 == s2)
+    return jz_true;
   if (s1->length != s2->length)
     return jz_false;
   if (JZ_STR_IS_HASHED(s1) && JZ_STR_IS_HASHED(s2) && s1->hash != s2->hash)
@@ -280,3 +309,159 @@ unsigned int jz_str_hash(JZ_STATE, jz_str* this) {
 
   return hash;
 }
+
+jz_str* jz_str_intern(JZ_STATE, jz_str* this) {
+  jz_str* atom;
+
+  if (JZ_STR_IS_ATOM(this)) return this;
+
+  atom = jz_str_find_atom(jz, this);
+  if (atom != NULL) return atom;
+
+  /* Atoms can live a long time,
+     so they shouldn't hold on to external data
+     or to the rest of a larger string. */
+  if ((JZ_STR_IS_EXT(this) && this->length != 0) || this->start != 0)
+    this = jz_str_deep_dup(jz, this);
+
+  jz_str_hash(jz, this);
+  this->interned = jz_true;
+  add_atom(jz, this);
+
+  return this;
+}
+
+jz_str* jz_str_find_atom(JZ_STATE, jz_str* this) {
+  jz_str** slot;
+
+  if (JZ_STR_IS_ATOM(this)) return this;
+
+  slot = find_atom(jz, this);
+  if (slot == NULL) return NULL;
+
+  /* The table doesn't mark its atoms,
+     so one that's handed out mid-cycle has to be marked here. */
+  if (jz_gc_write_barrier_active(jz))
+    jz_gc_mark_gray(jz, &(*slot)->gc);
+
+  return *slot;
+}
+
+jz_str* jz_str_atom_from_chars(JZ_STATE, const char* value, int length) {
+  UChar buffer[ATOM_BUFFER_LENGTH];
+  jz_str probe;
+  UErrorCode error = U_ZERO_ERROR;
+
+  if (length <= ATOM_BUFFER_LENGTH) {
+    JZ_GC_TAG(&probe) = 0;
+    SET_EXT(&probe);
+    probe.start = 0;
+    probe.interned = jz_false;
+    probe.value.ext = buffer;
+    u_strFromUTF8(buffer, ATOM_BUFFER_LENGTH, &probe.length,
+                  value, length, &error);
+
+    if (U_SUCCESS(error)) {
+      jz_str* atom = jz_str_find_atom(jz, &probe);
+      if (atom != NULL) return atom;
+    }
+  }
+
+  return jz_str_intern(jz, jz_str_from_chars(jz, value, length));
+}
+
+void jz_str_init_atoms(JZ_STATE) {
+  jz->atoms.capacity = MIN_ATOMS;
+  jz->atoms.size = 0;
+  jz->atoms.removed = 0;
+  jz->atoms.table = calloc(sizeof(jz_str*), MIN_ATOMS);
+}
+
+/* Called by the GC when an atom is freed. */
+void jz_str_remove_atom(JZ_STATE, jz_str* atom) {
+  size_t mask = jz->atoms.capacity - 1;
+  size_t i = atom->hash & mask;
+
+  /* There may be live atoms with the same contents in the chain,
+     so this goes by identity. */
+  for (; jz->atoms.table[i] != NULL; i = (i + 1) & mask) {
+    if (jz->atoms.table[i] == atom) {
+      jz->atoms.table[i] = REMOVED_ATOM;
+      jz->atoms.size--;
+      jz->atoms.removed++;
+      return;
+    }
+  }
+}
+
+void jz_str_free_atoms(JZ_STATE) {
+  free(jz->atoms.table);
+  jz->atoms.table = NULL;
+}
+
+/* Returns the slot in the atom table holding a live atom equal to 'str',
+   or NULL if there isn't one. */
+jz_str** find_atom(JZ_STATE, jz_str* str) {
+  unsigned int hash = jz_str_hash(jz, str);
+  size_t mask = jz->atoms.capacity - 1;
+  size_t i = hash & mask;
+
+  for (; jz->atoms.table[i] != NULL; i = (i + 1) & mask) {
+    jz_str* atom = jz->atoms.table[i];
+
+    if (atom != REMOVED_ATOM && atom->hash == hash &&
+        jz_str_equal(jz, atom, str) && !ATOM_IS_DEAD(jz, atom))
+      return jz->atoms.table + i;
+  }
+
+  return NULL;
+}
+
+/* Adds an atom that find_atom has just failed to find,
+   reusing the first removed slot in its chain if there is one. */
+void add_atom(JZ_STATE, jz_str* atom) {
+  size_t mask;
+  size_t i;
+
+  if ((jz->atoms.size + jz->atoms.removed + 1) * 2 > jz->atoms.capacity)
+    resize_atoms(jz);
+
+  mask = jz->atoms.capacity - 1;
+  for (i = atom->hash & mask; jz->atoms.table[i] != NULL; i = (i + 1) & mask) {
+    if (jz->atoms.table[i] == REMOVED_ATOM) {
+      jz->atoms.removed--;
+      break;
+    }
+  }
+
+  jz->atoms.table[i] = atom;
+  jz->atoms.size++;
+}
+
+/* Rebuilds the atom table without its removed slots; see MIN_ATOMS. */
+void resize_atoms(JZ_STATE) {
+  jz_str** old_table = jz->atoms.table;
+  size_t old_capacity = jz->atoms.capacity;
+  size_t mask;
+  size_t i;
+
+  jz->atoms.capacity = MIN_ATOMS;
+  while ((jz->atoms.size + 1) * 4 > jz->atoms.capacity)
+    jz->atoms.capacity *= 2;
+  jz->atoms.table = calloc(sizeof(jz_str*), jz->atoms.capacity);
+  jz->atoms.removed = 0;
+  mask = jz->atoms.capacity - 1;
+
+  for (i = 0; i < old_capacity; i++) {
+    jz_str* atom = old_table[i];
+    size_t j;
+
+    if (atom == NULL || atom == REMOVED_ATOM)
+      continue;
+
+    for (j = atom->hash & mask; jz->atoms.table[j] != NULL; j = (j + 1) & mask);
+    jz->atoms.table[j] = atom;
+  }
+
+  free(old_table);
+}
@@ -16,6 +16,7 @@ struct jz_str {
   int start;
   int length;
   unsigned int hash; /* TODO: uint32 */
+  jz_bool interned; /* Whether this is in the atom table. */
   union {
     const UChar* ext;
     jz_str_value* val;
@@ -30,6 +31,8 @@ struct jz_str {
 
 #define JZ_STR_IS_HASHED(str) JZ_BIT(str->gc.tag, JZ_STR_HASHED_BIT)
 
+#define JZ_STR_IS_ATOM(str) ((str)->interned)
+
 #define JZ_STR_PTR(string)                              \
   ((JZ_STR_IS_EXT(string) ? (string)->value.ext :       \
     (string)->value.val->str) + (string)->start)
@@ -102,9 +105,34 @@ unsigned int jz_str_hash(JZ_STATE, jz_str* this);
    transcoded into UTF-8. */
 char* jz_str_to_chars(JZ_STATE, const jz_str* this);
 
-#define jz_str_from_literal(jz, value)           \
-  jz_str_from_chars(jz, value, sizeof(value) - 1)
+/* Returns the atom for a C string literal. */
+#define jz_str_from_literal(jz, value)                  \
+  jz_str_atom_from_chars(jz, value, sizeof(value) - 1)
 
 jz_str* jz_str_from_chars(JZ_STATE, const char* value, int length);
 
+/* Atoms are canonical strings:
+   no two atoms have the same contents,
+   so atoms can be compared by pointer.
+   Object property keys are always atoms.
+
+   The atom table doesn't keep its strings alive;
+   atoms that are no longer referenced are removed when they're collected. */
+
+/* Returns the atom with the same contents as 'this',
+   making 'this' (or a copy of it) an atom if there isn't one yet. */
+jz_str* jz_str_intern(JZ_STATE, jz_str* this);
+
+/* Returns the atom with the same contents as 'this',
+   or NULL if there isn't one. */
+jz_str* jz_str_find_atom(JZ_STATE, jz_str* this);
+
+/* Like jz_str_intern(jz_str_from_chars(...)),
+   but doesn't allocate anything if the atom already exists. */
+jz_str* jz_str_atom_from_chars(JZ_STATE, const char* value, int length);
+
+void jz_str_init_atoms(JZ_STATE);
+void jz_str_remove_atom(JZ_STATE, jz_str* atom);
+void jz_str_free_atoms(JZ_STATE);
+
 #endif
@@ -98,30 +98,56 @@ double jz_values_comp(JZ_STATE, jz_val v1, jz_val v2) {
   return num1 - num2;
 }
 
-jz_val jz_wrap_int(JZ_STATE, int num) {
-  if (num > JZ_INT_MAX || num < JZ_INT_MIN)
+jz_val jz_wrap_int(JZ_STATE, jz_sival num) {
+  if (!JZ_INT_FITS(num))
     return jz_wrap_num(jz, (double)num);
 
-  return (jz_val)((num << 2) + jz_tt_int);
+  return jz_wrap_small_int(jz, num);
 }
 
 jz_val jz_wrap_num(JZ_STATE, double num) {
+#if JZ_NAN_BOXING
+  union {
+    double num;
+    jz_ival bits;
+  } u;
+#else
   jz_num* val;
+#endif
 
   if (JZ_NUM_IS_INT(num) && !JZ_NUM_IS_NEG_0(num) &&
       num < JZ_INT_MAX && num > JZ_INT_MIN)
-    return jz_wrap_int(jz, num);
+    return jz_wrap_small_int(jz, (jz_sival)num);
 
+#if JZ_NAN_BOXING
+  if (JZ_NUM_IS_NAN(num)) u.bits = JZ_CANONICAL_NAN_BITS;
+  else u.num = num;
+
+  return (jz_val)(u.bits + JZ_DOUBLE_OFFSET);
+#else
   val = (jz_num*)jz_gc_malloc(jz, jz_t_num, sizeof(jz_num));
   val->num = num;
   return val;
+#endif
 }
 
 double jz_to_num(JZ_STATE, jz_val val) {
   switch (JZ_VAL_TYPE(val)) {
   case jz_t_bool:
-  case jz_t_int:   return (double)((int)(val) >> 2);
+  case jz_t_int:   return (double)jz_unwrap_int(jz, val);
+#if JZ_NAN_BOXING
+  case jz_t_num: {
+    union {
+      double num;
+      jz_ival bits;
+    } u;
+
+    u.bits = (jz_ival)val - JZ_DOUBLE_OFFSET;
+    return u.num;
+  }
+#else
   case jz_t_num:   return ((jz_num*)val)->num;
+#endif
   case jz_t_undef: return JZ_NAN;
   case jz_t_str:   return jz_str_to_num(jz, jz_to_str(jz, val));
   case jz_t_obj:
@@ -173,7 +199,7 @@ jz_obj* jz_to_obj(JZ_STATE, jz_val val) {
 jz_bool jz_to_bool(JZ_STATE, jz_val val) {
   switch (JZ_VAL_TYPE(val)) {
   case jz_t_bool:
-  case jz_t_int: return (jz_bool)((int)(val) >> 2);
+  case jz_t_int: return jz_unwrap_int(jz, val) != 0;
   case jz_t_num: {
     double num = jz_to_num(jz, val);
 
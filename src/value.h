@@ -3,6 +3,7 @@
 
 #include <math.h>
 #include <float.h>
+#include <stdint.h>
 
 #include "jazz.h"
 
@@ -16,16 +17,17 @@ typedef enum {
 typedef enum {
   jz_ct_false,
   jz_ct_true,
-  jz_ct_undef
+  jz_ct_undef,
+  jz_ct_hole /* See JZ_HOLE in cells.h. */
 } jz_const_type;
 
 typedef void* jz_val;
 
-/* The integral type that jz_val is converted to
+/* The integral types that jz_val is converted to
    to do bit-twiddling and so forth.
-
-   TODO: Really an unsigned int? */
-typedef unsigned int jz_ival;
+   These are always the same size as a pointer. */
+typedef uintptr_t jz_ival;
+typedef intptr_t jz_sival;
 
 /* This tag stores type information
    and various other sorts of metadata
@@ -49,6 +51,8 @@ typedef enum {
   jz_t_obj,
   jz_t_proto,
   jz_t_bytecode,
+  jz_t_shape,
+  jz_t_free, /* An unused slot in a GC page. */
 
   /* Non-GCable types */
   jz_t_void,
@@ -63,7 +67,6 @@ struct jz_gc_header {
      The second two (2 and 3) may be used by individual structs
      for any tagging they need. */
   jz_tag tag;
-  jz_gc_header* next;
 };
 
 typedef enum {
@@ -75,9 +78,42 @@ typedef enum {
 #define JZ_TAG_TYPE(tag) ((tag) >> 4)
 #define JZ_TAG_WITH_TYPE(tag, type) (((tag) & ~0xf0) | ((type) << 4))
 
+/* With JZ_NAN_BOXING, doubles are stored directly in jz_vals
+   rather than being allocated on the heap as jz_nums.
+
+   On x86-64 and friends, pointers only use the low 48 bits,
+   so every jz_val that isn't a double
+   (a pointer, constant, void, or tagged int)
+   has its top 16 bits either all clear or, for negative ints, all set.
+   A double is stored as its bit pattern plus 2^48,
+   which puts its top 16 bits somewhere in between.
+   That works for every double except NaNs with the sign bit set,
+   so all NaNs are stored as the same canonical quiet NaN.
+
+   This only works with 64-bit pointers;
+   other platforms always allocate jz_nums. */
+#if JZ_NAN_BOXING && UINTPTR_MAX <= 0xffffffffUL
+#undef JZ_NAN_BOXING
+#endif
+
+#ifndef JZ_NAN_BOXING
+#define JZ_NAN_BOXING 0
+#endif
+
+#if JZ_NAN_BOXING
+#define JZ_DOUBLE_OFFSET ((jz_ival)1 << 48)
+#define JZ_CANONICAL_NAN_BITS ((jz_ival)0x7ff8 << 48)
+
+#define JZ_VAL_IS_DOUBLE(value) \
+  ((((jz_ival)(value)) + JZ_DOUBLE_OFFSET) >> 49 != 0)
+#else
+#define JZ_VAL_IS_DOUBLE(value) jz_false
+#endif
+
 #define JZ_VAL_TAG(value) (((jz_ival)(value)) & 3)
 #define JZ_VAL_TYPE(value)                              \
   ((value) == NULL                  ? jz_t_obj     :    \
+   JZ_VAL_IS_DOUBLE(value)          ? jz_t_num     :    \
    JZ_VAL_TAG(value) == jz_tt_void  ? jz_t_void    :    \
    JZ_VAL_TAG(value) == jz_tt_int   ? jz_t_int     :    \
    (value) == JZ_UNDEFINED          ? jz_t_undef   :    \
@@ -87,12 +123,18 @@ typedef enum {
 
 #define JZ_IS_GC_TYPE(val, type)                       \
   (val != NULL && JZ_VAL_TAG(val) == jz_tt_ptr &&      \
+   !JZ_VAL_IS_DOUBLE(val) &&                           \
    JZ_TAG_TYPE(((jz_gc_header*)val)->tag) == type)
 
-#define JZ_VAL_CAN_BE_GCED(val) \
-  (!JZ_VAL_IS_NULL(val) && JZ_VAL_TAG(val) == jz_tt_ptr)
+#define JZ_VAL_CAN_BE_GCED(val)                                 \
+  (!JZ_VAL_IS_NULL(val) && JZ_VAL_TAG(val) == jz_tt_ptr &&      \
+   !JZ_VAL_IS_DOUBLE(val))
+
+#define JZ_VAL_IS_INT(val) \
+  (JZ_VAL_TAG(val) == jz_tt_int && !JZ_VAL_IS_DOUBLE(val))
 
-#define JZ_VAL_IS_CONST(val) (JZ_VAL_TAG(val) == jz_tt_const)
+#define JZ_VAL_IS_CONST(val) \
+  (JZ_VAL_TAG(val) == jz_tt_const && !JZ_VAL_IS_DOUBLE(val))
 #define JZ_VAL_IS_NULL(val) ((val) == NULL)
 
 #define JZ_VAL_IS_PRIMITIVE(val) \
@@ -109,8 +151,24 @@ typedef enum {
 #define JZ_TYPE_IS_NUM(t) (t == jz_t_num || t == jz_t_int)
 #define JZ_IS_NUM(v) (JZ_TYPE_IS_NUM(JZ_VAL_TYPE(v)))
 
-#define JZ_INT_MAX ((1 << ((sizeof(void*) * 8) - 3)) - 1)
-#define JZ_INT_MIN (-(1 << ((sizeof(void*) * 8) - 3)))
+/* The number of bits in a tagged int, including the sign bit.
+
+   With JZ_NAN_BOXING, a tagged int has to leave the top 16 bits
+   all clear or all set, which leaves 46 bits.
+   Otherwise ints could use all but the two tag bits,
+   but they're kept within the 53 bits a double represents exactly
+   so that integer arithmetic gives the same results as doubles would. */
+#if JZ_NAN_BOXING
+#define JZ_INT_BITS 46
+#elif UINTPTR_MAX > 0xffffffffUL
+#define JZ_INT_BITS 54
+#else
+#define JZ_INT_BITS 30
+#endif
+
+#define JZ_INT_MAX (((jz_sival)1 << (JZ_INT_BITS - 1)) - 1)
+#define JZ_INT_MIN (-((jz_sival)1 << (JZ_INT_BITS - 1)))
+#define JZ_INT_FITS(num) ((num) <= JZ_INT_MAX && (num) >= JZ_INT_MIN)
 
 #define JZ_UNDEFINED ((jz_val)((jz_ct_undef << 2) + jz_tt_const))
 #define JZ_TRUE      ((jz_val)((jz_ct_true  << 2) + jz_tt_const))
@@ -138,8 +196,13 @@ double jz_values_comp(JZ_STATE, jz_val v1, jz_val v2);
 #define jz_to_wrapped_bool(jz, val) \
   (jz_wrap_bool(jz, jz_to_bool(jz, val)))
 
-jz_val jz_wrap_int(JZ_STATE, int num);
+jz_val jz_wrap_int(JZ_STATE, jz_sival num);
 jz_val jz_wrap_num(JZ_STATE, double num);
+
+/* Tags an integer that's known to be within JZ_INT_FITS. */
+#define jz_wrap_small_int(jz, num) \
+  ((jz_val)(((jz_ival)(num) << 2) + jz_tt_int))
+#define jz_unwrap_int(jz, val) (((jz_sival)(val)) >> 2)
 #define jz_wrap_bool(jz, b) ((jz_val)((((b) ? 1 : 0) << 2) + jz_tt_const))
 #define jz_wrap_void(jz, ptr) ((jz_val)(((jz_ival)(ptr)) | jz_tt_void))
 
@@ -4,26 +4,64 @@
 #include "string.h"
 #include "gc.h"
 #include "object.h"
+#include "ic.h"
+#include "cells.h"
+#include "function.h"
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <assert.h>
 
 const char* jz_oc_names[] = {
-  "jump", "jump_unless", "jump_if", "store_global", "retrieve",
-  "store", "closure_retrieve", "closure_store", "load_global", "call",
-  "push_literal", "push_closure", "push_global", "push_obj", "index",
-  "index_store", "pop", "dup", "dup2", "rot4", "bw_or", "xor",
+  "jump", "jump_unless", "jump_if", "lt_locals_jump_unless",
+  "lt_local_const_jump_unless", "bw_or_r", "xor_r", "bw_and_r",
+  "equals_r", "strict_eq_r", "lt_r", "gt_r", "lt_eq_r", "gt_eq_r",
+  "lshift_r", "rshift_r", "urshift_r", "add_r", "sub_r", "times_r",
+  "div_r", "mod_r", "add_local_const", "move_r", "load_global",
+  "store_global", "retrieve", "store", "closure_retrieve", "closure_store",
+  "capture_retrieve", "call", "tail_call", "push_literal", "push_closure", "inc_local", "dec_local",
+  "index", "index_store", "push_global", "push_obj", "pop", "dup", "dup2", "rot4", "bw_or", "xor",
   "bw_and", "equals", "strict_eq", "lt", "gt", "lt_eq", "gt_eq",
   "lshift", "rshift", "urshift", "add", "sub", "times", "div", "mod",
   "to_num", "neg", "bw_not", "not", "ret", "end", "noop"
 };
 
+/* With JZ_THREADED_DISPATCH, each opcode jumps straight to the next one
+   through a table of label addresses
+   rather than going back around the loop to a single shared switch.
+   That gives every opcode its own indirect branch,
+   which the CPU's branch predictor handles much better.
+   Computed gotos are a GCC extension,
+   so other compilers always get the switch. */
+#if JZ_THREADED_DISPATCH && defined(__GNUC__)
+#define THREADED 1
+#else
+#define THREADED 0
+#endif
+
 #define NEXT_OPCODE (*((code)++))
+
+#if THREADED
+#define CASE(op) label_ ## op: case jz_oc_ ## op
+/* __extension__ keeps -pedantic quiet about the computed goto,
+   as it does for dispatch_table. */
+#define NEXT __extension__ ({ goto *dispatch_table[NEXT_OPCODE]; })
+#else
+#define CASE(op) case jz_oc_ ## op
+#define NEXT break
+#endif
+
 #define READ_ARG_INTO(type, var)                \
   type var = *(type*)(code);                    \
   code += sizeof(type)/sizeof(jz_opcode);
 
+/* Like READ_ARG_INTO, but for an already-declared variable,
+   so that opcodes with several arguments can read them in order. */
+#define READ_ARG(type, var) {                   \
+    var = *(type*)(code);                       \
+    code += sizeof(type)/sizeof(jz_opcode);     \
+  }
+
 #define POP()     (*(--stack))
 #define PUSH_NO_WB(val) (*(stack++) = (val))
 #define PUSH(val) {                             \
@@ -41,6 +79,179 @@ const char* jz_oc_names[] = {
       JZ_GC_MARK_VAL_GRAY(jz, tmp);             \
   }
 
+/* Locals are GC roots, so values that are stored straight into them
+   without going through the stack need to be marked gray
+   just like values pushed onto the stack. */
+#define LOCAL_SET(i, val) {                     \
+    jz_val tmp = (val);                         \
+    locals[(i)] = tmp;                          \
+    if (jz_gc_write_barrier_active(jz))         \
+      JZ_GC_MARK_VAL_GRAY(jz, tmp);             \
+  }
+
+/* Points the registers at 'frame'.
+   The code and stack pointers are set separately,
+   since they depend on whether the frame is starting or resuming. */
+#define LOAD_FRAME(new_frame) {                         \
+    frame = (new_frame);                                \
+    closure_vars = JZ_FRAME_CLOSURE_VARS(frame);        \
+    locals = JZ_FRAME_LOCALS(frame);                    \
+    consts = frame->bytecode->consts;                   \
+    captures = FRAME_CAPTURES(frame);                   \
+    frame->stack_top = &stack;                          \
+  }
+
+/* The copies of outer variables that the frame's function was made with
+   (see jz_capture in compile.h). */
+#define FRAME_CAPTURES(frame)                                   \
+  ((frame)->function == NULL ? NULL :                           \
+   JZ_FUNC_DATA((frame)->function)->captures)
+
+/* Returns from the current frame.
+   If the frame was called from another one in this loop,
+   that picks up where it left off. */
+#define RETURN(val) {                           \
+    jz_val res = (val);                         \
+                                                \
+    jz_frame_free_current(jz);                  \
+    if (frame == entry)                         \
+      return res;                               \
+                                                \
+    LOAD_FRAME(jz->current_frame);              \
+    code = frame->code;                         \
+    stack = frame->stack;                       \
+    STACK_SET(-1, res);                         \
+    jz_gc_safepoint(jz);                        \
+    NEXT;                                       \
+  }
+
+/* The most arguments tail_call copies aside
+   to reuse the caller's frame. */
+#define TAIL_CALL_MAX_ARGS 8
+
+/* Register operands: see JZ_RK in opcode.h. */
+#define RK(rk) \
+  (JZ_RK_IS_CONST(rk) ? consts[JZ_RK_INDEX(rk)] : locals[(rk)])
+
+/* Operators on tagged ints work on the ints directly
+   rather than converting them to doubles and back.
+   Sums and differences of two ints can't overflow a jz_sival,
+   but they may no longer fit in a tagged int,
+   in which case INT_RESULT wraps them as doubles.
+   int_res is a scratch variable declared in jz_vm_run_frame. */
+#define BOTH_INTS(v1, v2) (JZ_VAL_IS_INT(v1) && JZ_VAL_IS_INT(v2))
+#define INT_RESULT(expr)                                        \
+  (int_res = (expr), JZ_INT_FITS(int_res) ?                     \
+   jz_wrap_small_int(jz, int_res) : jz_wrap_num(jz, (double)int_res))
+
+/* ToInt32 and ToUint32 of a tagged int just drop the high bits. */
+#define TO_INT32(v)                                     \
+  (JZ_VAL_IS_INT(v) ?                                   \
+   (int)(unsigned int)jz_unwrap_int(jz, v) : jz_to_int32(jz, v))
+#define TO_UINT32(v)                                    \
+  (JZ_VAL_IS_INT(v) ?                                   \
+   (unsigned int)jz_unwrap_int(jz, v) : jz_to_uint32(jz, v))
+
+/* Products are only done on ints if both factors are small enough
+   that the result is guaranteed to fit. */
+#define SMALL_FACTOR(v) \
+  (jz_unwrap_int(jz, v) < SMALL_FACTOR_MAX && \
+   jz_unwrap_int(jz, v) > -SMALL_FACTOR_MAX)
+#define SMALL_FACTOR_MAX ((jz_sival)1 << ((JZ_INT_BITS - 2) / 2))
+
+/* The semantics of the binary operators,
+   shared between their stack and register forms. */
+#define OP_BW_OR(v1, v2)  INT_RESULT(TO_INT32(v1) | TO_INT32(v2))
+#define OP_XOR(v1, v2)    INT_RESULT(TO_INT32(v1) ^ TO_INT32(v2))
+#define OP_BW_AND(v1, v2) INT_RESULT(TO_INT32(v1) & TO_INT32(v2))
+
+#define OP_EQUALS(v1, v2)                               \
+  jz_wrap_bool(jz, BOTH_INTS(v1, v2) ? (v1) == (v2) :   \
+               jz_values_equal(jz, v1, v2))
+#define OP_STRICT_EQ(v1, v2)                            \
+  jz_wrap_bool(jz, BOTH_INTS(v1, v2) ? (v1) == (v2) :   \
+               jz_values_strict_equal(jz, v1, v2))
+
+/* Comparisons with NaN are always false,
+   which falls out of the comparisons with 0. */
+#define COMPARE(v1, v2, op)                                             \
+  (BOTH_INTS(v1, v2) ? jz_unwrap_int(jz, v1) op jz_unwrap_int(jz, v2) : \
+   jz_values_comp(jz, v1, v2) op 0)
+#define OP_LT(v1, v2)    jz_wrap_bool(jz, COMPARE(v1, v2, <))
+#define OP_GT(v1, v2)    jz_wrap_bool(jz, COMPARE(v1, v2, >))
+#define OP_LT_EQ(v1, v2) jz_wrap_bool(jz, COMPARE(v1, v2, <=))
+#define OP_GT_EQ(v1, v2) jz_wrap_bool(jz, COMPARE(v1, v2, >=))
+
+#define OP_LSHIFT(v1, v2)                                       \
+  INT_RESULT((int)((unsigned int)TO_INT32(v1) <<                \
+                   (TO_UINT32(v2) & 0x1F)))
+#define OP_RSHIFT(v1, v2) \
+  INT_RESULT(TO_INT32(v1) >> (TO_UINT32(v2) & 0x1F))
+#define OP_URSHIFT(v1, v2) \
+  UINT_RESULT(TO_UINT32(v1) >> (TO_UINT32(v2) & 0x1F))
+/* Like INT_RESULT, but for unsigned ints that might not fit in a jz_sival
+   on 32-bit machines. */
+#define UINT_RESULT(expr)                                               \
+  (uint_res = (expr), uint_res <= (unsigned long)JZ_INT_MAX ?          \
+   jz_wrap_small_int(jz, uint_res) : jz_wrap_num(jz, (double)uint_res))
+
+#define OP_ADD(v1, v2)                                                  \
+  (BOTH_INTS(v1, v2) ?                                                  \
+   INT_RESULT(jz_unwrap_int(jz, v1) + jz_unwrap_int(jz, v2)) :          \
+   add(jz, v1, v2))
+#define OP_SUB(v1, v2)                                                  \
+  (BOTH_INTS(v1, v2) ?                                                  \
+   INT_RESULT(jz_unwrap_int(jz, v1) - jz_unwrap_int(jz, v2)) :          \
+   jz_wrap_num(jz, jz_to_num(jz, v1) - jz_to_num(jz, v2)))
+
+/* Products, quotients, and remainders of ints
+   fall back on doubles if the result would be -0. */
+#define OP_TIMES(v1, v2)                                                \
+  (BOTH_INTS(v1, v2) && SMALL_FACTOR(v1) && SMALL_FACTOR(v2) &&         \
+   (int_res = jz_unwrap_int(jz, v1) * jz_unwrap_int(jz, v2),            \
+    int_res != 0 ||                                                     \
+    (jz_unwrap_int(jz, v1) >= 0 && jz_unwrap_int(jz, v2) >= 0)) ?       \
+   jz_wrap_small_int(jz, int_res) :                                     \
+   jz_wrap_num(jz, jz_to_num(jz, v1) * jz_to_num(jz, v2)))
+/* Only exact quotients are done on ints. */
+#define OP_DIV(v1, v2)                                                  \
+  (BOTH_INTS(v1, v2) && jz_unwrap_int(jz, v2) != 0 &&                   \
+   jz_unwrap_int(jz, v1) % jz_unwrap_int(jz, v2) == 0 &&                \
+   (jz_unwrap_int(jz, v1) != 0 || jz_unwrap_int(jz, v2) > 0) ?          \
+   INT_RESULT(jz_unwrap_int(jz, v1) / jz_unwrap_int(jz, v2)) :          \
+   jz_wrap_num(jz, jz_to_num(jz, v1) / jz_to_num(jz, v2)))
+/* C89 leaves the sign of % on negative operands up to the compiler,
+   so only positive operands are done on ints. */
+#define OP_MOD(v1, v2)                                                  \
+  (BOTH_INTS(v1, v2) &&                                                 \
+   jz_unwrap_int(jz, v1) >= 0 && jz_unwrap_int(jz, v2) > 0 ?            \
+   jz_wrap_small_int(jz, jz_unwrap_int(jz, v1) % jz_unwrap_int(jz, v2)) : \
+   jz_wrap_num(jz, jz_num_mod(jz, v1, v2)))
+
+/* Replaces the top two values on the stack with the result of op.
+   'set' is STACK_SET or STACK_SET_NO_WB,
+   depending on whether the result can be a GCed value. */
+#define STACK_BINOP(op, set) {                  \
+    set(-2, op(stack[-2], stack[-1]));          \
+    stack--;                                    \
+    NEXT;                                       \
+  }
+
+/* Stores the result of op on two RK operands in a local. */
+#define REGISTER_BINOP(op) {                    \
+    jz_index dst;                               \
+    jz_index src1;                              \
+    jz_index src2;                              \
+    READ_ARG(jz_index, dst);                    \
+    READ_ARG(jz_index, src1);                   \
+    READ_ARG(jz_index, src2);                   \
+                                                \
+    LOCAL_SET(dst, op(RK(src1), RK(src2)));     \
+    NEXT;                                       \
+  }
+
+static jz_val add(JZ_STATE, jz_val v1, jz_val v2);
+
 #if JZ_DEBUG_BYTECODE
 static void print_bytecode(const jz_bytecode* bytecode);
 #endif
@@ -49,12 +260,49 @@ jz_val jz_vm_run(JZ_STATE, jz_bytecode* bytecode) {
   return jz_vm_run_frame(jz, jz_frame_new(jz, bytecode));
 }
 
+/* Calls from one script function to another
+   push a frame and carry on in the same loop,
+   so only calls to and from native code use up the C stack.
+   'entry' is the frame this was called with,
+   and returning from it returns from this. */
 jz_val jz_vm_run_frame(JZ_STATE, jz_frame* frame) {
+  jz_frame* entry = frame;
   jz_opcode* code = frame->bytecode->code;
   jz_val* stack = JZ_FRAME_STACK(frame);
   jz_val** closure_vars = JZ_FRAME_CLOSURE_VARS(frame);
   jz_val* locals = JZ_FRAME_LOCALS(frame);
   jz_val* consts = frame->bytecode->consts;
+  jz_val* captures = FRAME_CAPTURES(frame);
+  /* Scratch space for the integer fast paths in OP_ADD and friends. */
+  jz_sival int_res;
+  unsigned long uint_res;
+
+#if THREADED
+  /* This must be kept in the same order as jz_oc_type in opcode.h. */
+  __extension__ static const void* const dispatch_table[jz_oc_last] = {
+    &&label_jump, &&label_jump_unless, &&label_jump_if,
+    &&label_lt_locals_jump_unless, &&label_lt_local_const_jump_unless,
+    &&label_bw_or_r, &&label_xor_r, &&label_bw_and_r, &&label_equals_r,
+    &&label_strict_eq_r, &&label_lt_r, &&label_gt_r, &&label_lt_eq_r,
+    &&label_gt_eq_r, &&label_lshift_r, &&label_rshift_r, &&label_urshift_r,
+    &&label_add_r, &&label_sub_r, &&label_times_r, &&label_div_r,
+    &&label_mod_r, &&label_add_local_const, &&label_move_r,
+    &&label_load_global, &&label_store_global,
+    &&label_retrieve, &&label_store, &&label_closure_retrieve,
+    &&label_closure_store, &&label_capture_retrieve,
+    &&label_call, &&label_tail_call,
+    &&label_push_literal, &&label_push_closure, &&label_inc_local,
+    &&label_dec_local, &&label_index, &&label_index_store,
+    &&label_push_global, &&label_push_obj, &&label_pop,
+    &&label_dup, &&label_dup2, &&label_rot4, &&label_bw_or, &&label_xor,
+    &&label_bw_and, &&label_equals, &&label_strict_eq, &&label_lt,
+    &&label_gt, &&label_lt_eq, &&label_gt_eq, &&label_lshift,
+    &&label_rshift, &&label_urshift, &&label_add, &&label_sub,
+    &&label_times, &&label_div, &&label_mod, &&label_to_num, &&label_neg,
+    &&label_bw_not, &&label_not, &&label_ret, &&label_end,
+    &&label_unknown /* noop */
+  };
+#endif
 
   frame->stack_top = &stack;
 
@@ -63,17 +311,18 @@ jz_val jz_vm_run_frame(JZ_STATE, jz_frame* frame) {
   printf("Locals length: %lu\n", (unsigned long)frame->bytecode->locals_length);
 #endif
 
-  while (jz_true) {
-    jz_gc_tick(jz);
+  /* Function calls are safepoints. See jz_gc_safepoint in gc.h. */
+  jz_gc_safepoint(jz);
 
+  while (jz_true) {
     switch (NEXT_OPCODE) {
-    case jz_oc_push_literal: {
+    CASE(push_literal): {
       READ_ARG_INTO(jz_index, index);
       PUSH_NO_WB(consts[index]);
-      break;
+      NEXT;
     }
 
-    case jz_oc_push_closure: {
+    CASE(push_closure): {
       jz_obj* func;
       READ_ARG_INTO(jz_index, index);
       func = (jz_obj*)consts[index];
@@ -82,20 +331,57 @@ jz_val jz_vm_run_frame(JZ_STATE, jz_frame* frame) {
       func = jz_func_dup(jz, func);
       PUSH(func);
       jz_func_set_scope(jz, func, frame);
-      break;
+      NEXT;
     }
 
-    case jz_oc_push_global: {
+    CASE(push_global): {
       PUSH_NO_WB(jz->global_obj);
-      break;
+      NEXT;
     }
 
-    case jz_oc_push_obj: {
+    CASE(push_obj): {
       PUSH(jz_obj_new(jz));
-      break;
+      NEXT;
+    }
+
+    /* A call whose result is returned straight away.
+       The current frame is popped before the callee's is pushed,
+       so the callee's frame lands in the same place
+       and returns to this frame's caller.
+       Nothing outside the frame can refer to it,
+       since captured variables are boxed
+       before any closure that could see them is made.
+
+       The arguments are copied out first,
+       since the new frame is written over them.
+       Calls to native functions, and calls with more arguments than that,
+       fall through to an ordinary call, followed by a ret. */
+    CASE(tail_call): {
+      jz_index argc = *(jz_index*)code;
+      jz_val obj = stack[-argc - 1];
+
+      if (JZ_VAL_TYPE(obj) == jz_t_obj && JZ_FUNC_IS_BYTECODE((jz_obj*)obj) &&
+          argc <= TAIL_CALL_MAX_ARGS) {
+        jz_val args[TAIL_CALL_MAX_ARGS];
+        jz_bool was_entry = frame == entry;
+        int i;
+
+        for (i = 0; i < argc; i++)
+          args[i] = stack[i - argc];
+        jz_frame_free_current(jz);
+
+        LOAD_FRAME(jz_func_new_frame(jz, (jz_obj*)obj, argc, args));
+        if (was_entry)
+          entry = frame;
+        code = frame->bytecode->code;
+        stack = JZ_FRAME_STACK(frame);
+
+        jz_gc_safepoint(jz);
+        NEXT;
+      }
     }
 
-    case jz_oc_call: {
+    CASE(call): {
       jz_val obj;
       jz_val v;
       READ_ARG_INTO(jz_index, argc);
@@ -111,274 +397,289 @@ jz_val jz_vm_run_frame(JZ_STATE, jz_frame* frame) {
       v = stack[-argc];
 
       jz->stack = (jz_byte*)stack;
+      if (JZ_FUNC_IS_BYTECODE((jz_obj*)obj)) {
+        /* The result goes where the function was. */
+        frame->code = code;
+        frame->stack = stack - argc;
+        frame->stack_top = &frame->stack;
+
+        LOAD_FRAME(jz_func_new_frame(jz, (jz_obj*)obj, argc, stack - argc));
+        code = frame->bytecode->code;
+        stack = JZ_FRAME_STACK(frame);
+
+        /* Function calls are safepoints. */
+        jz_gc_safepoint(jz);
+        NEXT;
+      }
+
       STACK_SET(-argc - 1, jz_call_arr(jz, (jz_obj*)obj, argc, stack - argc));
       stack -= argc;
-      break;
+      /* Native functions don't have safepoints of their own. */
+      jz_gc_safepoint(jz);
+      NEXT;
     }
 
-    case jz_oc_jump: {
+    CASE(jump): {
       READ_ARG_INTO(ptrdiff_t, jump);
       code += jump;
-      break;
+      /* Every loop has a jump back to its start. */
+      jz_gc_safepoint(jz);
+      NEXT;
     }
 
-    case jz_oc_jump_unless: {
+    CASE(jump_unless): {
       READ_ARG_INTO(ptrdiff_t, jump);
       if (!jz_to_bool(jz, POP())) code += jump;
-      break;
+      NEXT;
     }
 
-    case jz_oc_jump_if: {
+    CASE(jump_if): {
       READ_ARG_INTO(ptrdiff_t, jump);
       if (jz_to_bool(jz, POP())) code += jump;
-      break;
+      /* This is the jump back to the start of a do-while loop. */
+      jz_gc_safepoint(jz);
+      NEXT;
+    }
+
+    CASE(lt_locals_jump_unless): {
+      jz_index left;
+      jz_index right;
+      ptrdiff_t jump;
+      READ_ARG(jz_index, left);
+      READ_ARG(jz_index, right);
+      READ_ARG(ptrdiff_t, jump);
+
+      if (!COMPARE(locals[left], locals[right], <)) code += jump;
+      NEXT;
+    }
+
+    CASE(lt_local_const_jump_unless): {
+      jz_index left;
+      jz_index right;
+      ptrdiff_t jump;
+      READ_ARG(jz_index, left);
+      READ_ARG(jz_index, right);
+      READ_ARG(ptrdiff_t, jump);
+
+      if (!COMPARE(locals[left], consts[right], <)) code += jump;
+      NEXT;
     }
 
-    case jz_oc_store: {
+    CASE(store): {
       READ_ARG_INTO(jz_index, index);
       locals[index] = POP();
-      break;
+      NEXT;
     }
 
-    case jz_oc_index_store:
-      jz_obj_put(jz, jz_to_obj(jz, stack[-3]),
-                 jz_to_str(jz, stack[-2]), stack[-1]);
+    CASE(index_store): {
+      READ_ARG_INTO(jz_index, ic);
+
+      jz_ic_put(jz, frame->bytecode, ic, jz_to_obj(jz, stack[-3]),
+                jz_to_str(jz, stack[-2]), stack[-1]);
 
       stack -= 3;
-      break;
+      NEXT;
+    }
 
-    case jz_oc_store_global: {
+    CASE(store_global): {
       READ_ARG_INTO(jz_index, index);
 
-      jz_obj_put(jz, jz->global_obj, jz_to_str(jz, consts[index]), POP());
-      break;
+      JZ_CELL_SET(jz, index, POP());
+      NEXT;
     }
 
-    case jz_oc_closure_store: {
+    CASE(closure_store): {
+      jz_val val;
       READ_ARG_INTO(jz_index, index);
-      *(closure_vars[index]) = POP();
-      break;
+      val = POP();
+      *(closure_vars[index]) = val;
+      JZ_GC_WRITE_BARRIER_SLOT(jz, closure_vars[index], val);
+      NEXT;
     }
 
-    case jz_oc_retrieve: {
+    CASE(retrieve): {
       READ_ARG_INTO(jz_index, index);
       PUSH_NO_WB(locals[index]);
-      break;
+      NEXT;
     }
 
-    case jz_oc_index:
+    CASE(index): {
+      READ_ARG_INTO(jz_index, ic);
+
       if (JZ_VAL_TYPE(stack[-2]) != jz_t_obj) {
         fprintf(stderr, "Indexing not yet implemented for non-object values.\n");
         exit(1);
       }
-      STACK_SET(-2, jz_obj_get(jz, (jz_obj*)stack[-2], jz_to_str(jz, stack[-1])));
+      STACK_SET(-2, jz_ic_get(jz, frame->bytecode, ic, (jz_obj*)stack[-2],
+                              jz_to_str(jz, stack[-1])));
       stack--;
-      break;
+      NEXT;
+    }
 
-    case jz_oc_load_global: {
+    CASE(load_global): {
       READ_ARG_INTO(jz_index, index);
 
-      PUSH(jz_obj_get(jz, jz->global_obj, jz_to_str(jz, consts[index])));
-      break;
+      if (JZ_CELL(jz, index) != JZ_HOLE) {
+        PUSH_NO_WB(JZ_CELL(jz, index));
+      } else {
+        /* The global object's prototype might still have the property. */
+        PUSH(jz_obj_get(jz, jz->global_obj, JZ_CELL_NAME(jz, index)));
+      }
+      NEXT;
     }
 
-    case jz_oc_closure_retrieve: {
+    CASE(closure_retrieve): {
       READ_ARG_INTO(jz_index, index);
       PUSH(*(closure_vars[index]));
-      break;
+      NEXT;
     }
 
-    case jz_oc_pop:
+    CASE(capture_retrieve): {
+      READ_ARG_INTO(jz_index, index);
+      PUSH(captures[index]);
+      NEXT;
+    }
+
+    CASE(inc_local): {
+      READ_ARG_INTO(jz_index, index);
+      LOCAL_SET(index, OP_ADD(locals[index], jz_wrap_small_int(jz, 1)));
+      NEXT;
+    }
+
+    CASE(dec_local): {
+      READ_ARG_INTO(jz_index, index);
+      LOCAL_SET(index, OP_SUB(locals[index], jz_wrap_small_int(jz, 1)));
+      NEXT;
+    }
+
+    CASE(add_local_const): {
+      jz_index local;
+      jz_index literal;
+      READ_ARG(jz_index, local);
+      READ_ARG(jz_index, literal);
+
+      LOCAL_SET(local, OP_ADD(locals[local], consts[literal]));
+      NEXT;
+    }
+
+    CASE(pop):
       stack--;
-      break;
+      NEXT;
 
-    case jz_oc_dup: {
+    CASE(dup): {
       *stack = stack[-1];
       stack++;
-      break;
+      NEXT;
     }
 
-    case jz_oc_dup2: {
+    CASE(dup2): {
       stack[0] = stack[-2];
       stack[1] = stack[-1];
       stack += 2;
-      break;
+      NEXT;
     }
 
-    case jz_oc_rot4: {
+    CASE(rot4): {
       jz_val tmp = stack[-1];
 
       stack[-1] = stack[-2];
       stack[-2] = stack[-3];
       stack[-3] = stack[-4];
       stack[-4] = tmp;
-      break;
-    }
-
-    case jz_oc_bw_or:
-      STACK_SET(-2, jz_wrap_num(jz, jz_to_int32(jz, stack[-2]) |
-                                jz_to_int32(jz, stack[-1])));
-      stack--;
-      break;
-
-    case jz_oc_xor:
-      STACK_SET(-2, jz_wrap_num(jz, jz_to_int32(jz, stack[-2]) ^
-                                jz_to_int32(jz, stack[-1])));
-      stack--;
-      break;
-
-    case jz_oc_bw_and:
-      STACK_SET(-2, jz_wrap_num(jz, jz_to_int32(jz, stack[-2]) &
-                                jz_to_int32(jz, stack[-1])));
-      stack--;
-      break;
-
-    case jz_oc_equals:
-      STACK_SET_NO_WB(-2, jz_wrap_bool(jz, jz_values_equal(jz, stack[-2],
-                                                           stack[-1])));
-      stack--;
-      break;
-
-    case jz_oc_strict_eq: {
-      STACK_SET_NO_WB(-2, jz_wrap_bool(jz, jz_values_strict_equal(jz, stack[-2],
-                                                                  stack[-1])));
-      stack--;
-      break;
-    }
-
-    case jz_oc_lt: {
-      double comp = jz_values_comp(jz, stack[-2], stack[-1]);
-
-      if (JZ_NUM_IS_NAN(comp)) STACK_SET_NO_WB(-2, jz_wrap_bool(jz, jz_false));
-      else STACK_SET_NO_WB(-2, jz_wrap_bool(jz, comp < 0));
-
-      stack--;
-      break;
-    }
-
-    case jz_oc_gt: {
-      double comp = jz_values_comp(jz, stack[-2], stack[-1]);
-
-      if (JZ_NUM_IS_NAN(comp)) STACK_SET_NO_WB(-2, jz_wrap_bool(jz, jz_false));
-      else STACK_SET_NO_WB(-2, jz_wrap_bool(jz, comp > 0));
-
-      stack--;
-      break;
-    }
-
-    case jz_oc_lt_eq: {
-      double comp = jz_values_comp(jz, stack[-2], stack[-1]);
-
-      if (JZ_NUM_IS_NAN(comp)) STACK_SET_NO_WB(-2, jz_wrap_bool(jz, jz_false));
-      else STACK_SET_NO_WB(-2, jz_wrap_bool(jz, comp <= 0));
-
-      stack--;
-      break;
-    }
-
-    case jz_oc_gt_eq: {
-      double comp = jz_values_comp(jz, stack[-2], stack[-1]);
-
-      if (JZ_NUM_IS_NAN(comp)) STACK_SET_NO_WB(-2, jz_wrap_bool(jz, jz_false));
-      else STACK_SET_NO_WB(-2, jz_wrap_bool(jz, comp >= 0));
-
-      stack--;
-      break;
+      NEXT;
     }
 
-    case jz_oc_lshift:
-      STACK_SET(-2, jz_wrap_num(jz, jz_to_int32(jz, stack[-2]) <<
-                                (jz_to_uint32(jz, stack[-1]) & 0x1F)));
-      stack--;
-      break;
-
-    case jz_oc_rshift:
-      STACK_SET(-2, jz_wrap_num(jz, jz_to_int32(jz, stack[-2]) >>
-                                (jz_to_uint32(jz, stack[-1]) & 0x1F)));
-      stack--;
-      break;
-
-    case jz_oc_urshift:
-      STACK_SET(-2, jz_wrap_num(jz, (unsigned int)jz_to_int32(jz, stack[-2]) >>
-                                (jz_to_uint32(jz, stack[-1]) & 0x1F)));
-      stack--;
-      break;
-
-    case jz_oc_add: {
-      jz_val v1 = stack[-2];
-      jz_val v2 = stack[-1];
-
-      if (JZ_VAL_TYPE(v1) == jz_t_str || JZ_VAL_TYPE(v2) == jz_t_str) {
-        STACK_SET(-2, jz_str_concat(jz, jz_to_str(jz, v1),
-                                    jz_to_str(jz, v2)));
-      } else {
-        STACK_SET(-2, jz_wrap_num(jz, jz_to_num(jz, stack[-2]) +
-                                  jz_to_num(jz, stack[-1])));
-      }
-      stack--;
-      break;
+    CASE(bw_or): STACK_BINOP(OP_BW_OR, STACK_SET)
+    CASE(xor): STACK_BINOP(OP_XOR, STACK_SET)
+    CASE(bw_and): STACK_BINOP(OP_BW_AND, STACK_SET)
+    CASE(equals): STACK_BINOP(OP_EQUALS, STACK_SET_NO_WB)
+    CASE(strict_eq): STACK_BINOP(OP_STRICT_EQ, STACK_SET_NO_WB)
+    CASE(lt): STACK_BINOP(OP_LT, STACK_SET_NO_WB)
+    CASE(gt): STACK_BINOP(OP_GT, STACK_SET_NO_WB)
+    CASE(lt_eq): STACK_BINOP(OP_LT_EQ, STACK_SET_NO_WB)
+    CASE(gt_eq): STACK_BINOP(OP_GT_EQ, STACK_SET_NO_WB)
+    CASE(lshift): STACK_BINOP(OP_LSHIFT, STACK_SET)
+    CASE(rshift): STACK_BINOP(OP_RSHIFT, STACK_SET)
+    CASE(urshift): STACK_BINOP(OP_URSHIFT, STACK_SET)
+    CASE(add): STACK_BINOP(OP_ADD, STACK_SET)
+    CASE(sub): STACK_BINOP(OP_SUB, STACK_SET)
+    CASE(times): STACK_BINOP(OP_TIMES, STACK_SET)
+    CASE(div): STACK_BINOP(OP_DIV, STACK_SET)
+    CASE(mod): STACK_BINOP(OP_MOD, STACK_SET)
+
+    CASE(bw_or_r): REGISTER_BINOP(OP_BW_OR)
+    CASE(xor_r): REGISTER_BINOP(OP_XOR)
+    CASE(bw_and_r): REGISTER_BINOP(OP_BW_AND)
+    CASE(equals_r): REGISTER_BINOP(OP_EQUALS)
+    CASE(strict_eq_r): REGISTER_BINOP(OP_STRICT_EQ)
+    CASE(lt_r): REGISTER_BINOP(OP_LT)
+    CASE(gt_r): REGISTER_BINOP(OP_GT)
+    CASE(lt_eq_r): REGISTER_BINOP(OP_LT_EQ)
+    CASE(gt_eq_r): REGISTER_BINOP(OP_GT_EQ)
+    CASE(lshift_r): REGISTER_BINOP(OP_LSHIFT)
+    CASE(rshift_r): REGISTER_BINOP(OP_RSHIFT)
+    CASE(urshift_r): REGISTER_BINOP(OP_URSHIFT)
+    CASE(add_r): REGISTER_BINOP(OP_ADD)
+    CASE(sub_r): REGISTER_BINOP(OP_SUB)
+    CASE(times_r): REGISTER_BINOP(OP_TIMES)
+    CASE(div_r): REGISTER_BINOP(OP_DIV)
+    CASE(mod_r): REGISTER_BINOP(OP_MOD)
+
+    CASE(move_r): {
+      jz_index dst;
+      jz_index src;
+      READ_ARG(jz_index, dst);
+      READ_ARG(jz_index, src);
+
+      LOCAL_SET(dst, RK(src));
+      NEXT;
     }
 
-    case jz_oc_sub:
-      STACK_SET(-2, jz_wrap_num(jz, jz_to_num(jz, stack[-2]) -
-                                jz_to_num(jz, stack[-1])));
-      stack--;
-      break;
+    CASE(to_num):
+      if (!JZ_VAL_IS_INT(stack[-1]))
+        STACK_SET(-1, jz_wrap_num(jz, jz_to_num(jz, stack[-1])));
+      NEXT;
 
-    case jz_oc_times:
-      STACK_SET(-2, jz_wrap_num(jz, jz_to_num(jz, stack[-2]) *
-                                jz_to_num(jz, stack[-1])));
-      stack--;
-      break;
-
-    case jz_oc_div:
-      STACK_SET(-2, jz_wrap_num(jz, jz_to_num(jz, stack[-2]) /
-                                jz_to_num(jz, stack[-1])));
-      stack--;
-      break;
-
-    case jz_oc_mod:
-      STACK_SET(-2, jz_wrap_num(jz, jz_num_mod(jz, stack[-2], stack[-1])));
-      stack--;
-      break;
-
-    case jz_oc_to_num:
-      STACK_SET(-1, jz_wrap_num(jz, jz_to_num(jz, stack[-1])));
-      break;
-
-    case jz_oc_neg:
-      STACK_SET(-1, jz_wrap_num(jz, -jz_to_num(jz, stack[-1])));
-      break;
+    CASE(neg):
+      /* -0 isn't an int. */
+      if (JZ_VAL_IS_INT(stack[-1]) && stack[-1] != jz_wrap_small_int(jz, 0))
+        STACK_SET(-1, INT_RESULT(-jz_unwrap_int(jz, stack[-1])))
+      else STACK_SET(-1, jz_wrap_num(jz, -jz_to_num(jz, stack[-1])));
+      NEXT;
 
-    case jz_oc_bw_not:
-      STACK_SET(-1, jz_wrap_num(jz, ~jz_to_int32(jz, stack[-1])));
-      break;
+    CASE(bw_not):
+      STACK_SET(-1, INT_RESULT(~TO_INT32(stack[-1])));
+      NEXT;
 
-    case jz_oc_not:
+    CASE(not):
       STACK_SET_NO_WB(-1, jz_wrap_bool(jz, !jz_to_bool(jz, stack[-1])));
-      break;
+      NEXT;
 
-    case jz_oc_ret: {
-      jz_val res;
+    CASE(ret):
+      RETURN(stack[-1]);
 
-      res = stack[-1];
-      jz_frame_free_current(jz);
-      return res;
-    }
-
-    case jz_oc_end:
-      jz_frame_free_current(jz);
-      return JZ_UNDEFINED;
+    CASE(end):
+      RETURN(JZ_UNDEFINED);
 
     default:
+#if THREADED
+    label_unknown:
+#endif
       fprintf(stderr, "Unknown opcode %d\n", code[-1]);
       exit(1);
     }
-
-    jz_check_overflow(jz, (jz_byte*)stack);
   }
 }
 
+/* The + operator: string concatenation if either side is a string,
+   numeric addition otherwise. */
+jz_val add(JZ_STATE, jz_val v1, jz_val v2) {
+  if (JZ_VAL_TYPE(v1) == jz_t_str || JZ_VAL_TYPE(v2) == jz_t_str)
+    return jz_str_concat(jz, jz_to_str(jz, v1), jz_to_str(jz, v2));
+  else
+    return jz_wrap_num(jz, jz_to_num(jz, v1) + jz_to_num(jz, v2));
+}
+
 #if JZ_DEBUG_BYTECODE
 void print_bytecode(const jz_bytecode* bytecode) {
   jz_opcode* code;
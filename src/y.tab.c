@@ -0,0 +1,3121 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 1
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 1 "parse.y"
+
+#include "parse.h"
+#include "lex.h"
+#include "state.h"
+#include "string.h"
+#include "object.h"
+#include "_cons.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+
+const char* jz_parse_names[] = {
+  "block", "return", "if", "do-while", "while", "for", "switch", "var", "expr",
+  "literal", "id", "this", "call", "func", "cond", "||", "&&", ",", "|", "^",
+  "&", "==", "!=", "===", "!==", "<", ">", "<=", ">=", "<<", ">>", ">>>", "+",
+  "-", "*", "/", "%", "=", "*=", "/=", "%=", "+=", "-=", "<<=", ">>=", ">>>=",
+  "&=", "^=", "|=", "[]", "+@", "-@", "~", "!", "++@", "--@", "@++", "@--"
+};
+
+static void yyerror(JZ_STATE, jz_cons** root, jz_lex_state* state, const char* msg);
+
+#define binop_node(jz, type, left, right) jz_list(jz, 3, jz_enum_new(jz, type), (left), (right))
+#define unop_node(jz, type, next) jz_enum_wrap(jz, type, (next))
+
+#line 97 "y.tab.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+/* Use api.header.include to #include this header
+   instead of duplicating it here.  */
+#ifndef YY_YY_Y_TAB_H_INCLUDED
+# define YY_YY_Y_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    IDENTIFIER = 258,              /* IDENTIFIER  */
+    STRING = 259,                  /* STRING  */
+    INTEGER = 260,                 /* INTEGER  */
+    NUMBER = 261,                  /* NUMBER  */
+    TRUE_VAL = 262,                /* TRUE_VAL  */
+    FALSE_VAL = 263,               /* FALSE_VAL  */
+    NULL_VAL = 264,                /* NULL_VAL  */
+    THIS = 265,                    /* THIS  */
+    RETURN = 266,                  /* RETURN  */
+    VAR = 267,                     /* VAR  */
+    IF = 268,                      /* IF  */
+    ELSE = 269,                    /* ELSE  */
+    DO = 270,                      /* DO  */
+    WHILE = 271,                   /* WHILE  */
+    FOR = 272,                     /* FOR  */
+    SWITCH = 273,                  /* SWITCH  */
+    CASE = 274,                    /* CASE  */
+    DEFAULT = 275,                 /* DEFAULT  */
+    FUNCTION = 276,                /* FUNCTION  */
+    LCURLY = 277,                  /* LCURLY  */
+    RCURLY = 278,                  /* RCURLY  */
+    LPAREN = 279,                  /* LPAREN  */
+    RPAREN = 280,                  /* RPAREN  */
+    LSQUARE = 281,                 /* LSQUARE  */
+    RSQUARE = 282,                 /* RSQUARE  */
+    DOT = 283,                     /* DOT  */
+    SEMICOLON = 284,               /* SEMICOLON  */
+    COMMA = 285,                   /* COMMA  */
+    LESS_THAN = 286,               /* LESS_THAN  */
+    GREATER_THAN = 287,            /* GREATER_THAN  */
+    GT_EQ = 288,                   /* GT_EQ  */
+    LT_EQ = 289,                   /* LT_EQ  */
+    EQ_EQ = 290,                   /* EQ_EQ  */
+    NOT_EQ = 291,                  /* NOT_EQ  */
+    STRICT_EQ = 292,               /* STRICT_EQ  */
+    NOT_STRICT_EQ = 293,           /* NOT_STRICT_EQ  */
+    PLUS = 294,                    /* PLUS  */
+    MINUS = 295,                   /* MINUS  */
+    TIMES = 296,                   /* TIMES  */
+    MOD = 297,                     /* MOD  */
+    PLUS_PLUS = 298,               /* PLUS_PLUS  */
+    MINUS_MINUS = 299,             /* MINUS_MINUS  */
+    LSHIFT = 300,                  /* LSHIFT  */
+    RSHIFT = 301,                  /* RSHIFT  */
+    URSHIFT = 302,                 /* URSHIFT  */
+    BW_AND = 303,                  /* BW_AND  */
+    BW_OR = 304,                   /* BW_OR  */
+    XOR = 305,                     /* XOR  */
+    NOT = 306,                     /* NOT  */
+    BW_NOT = 307,                  /* BW_NOT  */
+    AND = 308,                     /* AND  */
+    OR = 309,                      /* OR  */
+    QUESTION = 310,                /* QUESTION  */
+    COLON = 311,                   /* COLON  */
+    EQUALS = 312,                  /* EQUALS  */
+    PLUS_EQ = 313,                 /* PLUS_EQ  */
+    MINUS_EQ = 314,                /* MINUS_EQ  */
+    TIMES_EQ = 315,                /* TIMES_EQ  */
+    MOD_EQ = 316,                  /* MOD_EQ  */
+    LSHIFT_EQ = 317,               /* LSHIFT_EQ  */
+    RSHIFT_EQ = 318,               /* RSHIFT_EQ  */
+    URSHIFT_EQ = 319,              /* URSHIFT_EQ  */
+    BW_AND_EQ = 320,               /* BW_AND_EQ  */
+    BW_OR_EQ = 321,                /* BW_OR_EQ  */
+    XOR_EQ = 322,                  /* XOR_EQ  */
+    DIV = 323,                     /* DIV  */
+    DIV_EQ = 324                   /* DIV_EQ  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 257
+#define IDENTIFIER 258
+#define STRING 259
+#define INTEGER 260
+#define NUMBER 261
+#define TRUE_VAL 262
+#define FALSE_VAL 263
+#define NULL_VAL 264
+#define THIS 265
+#define RETURN 266
+#define VAR 267
+#define IF 268
+#define ELSE 269
+#define DO 270
+#define WHILE 271
+#define FOR 272
+#define SWITCH 273
+#define CASE 274
+#define DEFAULT 275
+#define FUNCTION 276
+#define LCURLY 277
+#define RCURLY 278
+#define LPAREN 279
+#define RPAREN 280
+#define LSQUARE 281
+#define RSQUARE 282
+#define DOT 283
+#define SEMICOLON 284
+#define COMMA 285
+#define LESS_THAN 286
+#define GREATER_THAN 287
+#define GT_EQ 288
+#define LT_EQ 289
+#define EQ_EQ 290
+#define NOT_EQ 291
+#define STRICT_EQ 292
+#define NOT_STRICT_EQ 293
+#define PLUS 294
+#define MINUS 295
+#define TIMES 296
+#define MOD 297
+#define PLUS_PLUS 298
+#define MINUS_MINUS 299
+#define LSHIFT 300
+#define RSHIFT 301
+#define URSHIFT 302
+#define BW_AND 303
+#define BW_OR 304
+#define XOR 305
+#define NOT 306
+#define BW_NOT 307
+#define AND 308
+#define OR 309
+#define QUESTION 310
+#define COLON 311
+#define EQUALS 312
+#define PLUS_EQ 313
+#define MINUS_EQ 314
+#define TIMES_EQ 315
+#define MOD_EQ 316
+#define LSHIFT_EQ 317
+#define RSHIFT_EQ 318
+#define URSHIFT_EQ 319
+#define BW_AND_EQ 320
+#define BW_OR_EQ 321
+#define XOR_EQ 322
+#define DIV 323
+#define DIV_EQ 324
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 46 "parse.y"
+
+  struct jz_cons* node;
+  jz_str* str;
+  double num;
+  int i;
+  char boolean;
+  int operation;
+  jz_val val;
+  char none;
+
+#line 299 "y.tab.c"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+
+
+
+int yyparse (jz_state* jz, jz_cons** root, jz_lex_state* state);
+
+
+#endif /* !YY_YY_Y_TAB_H_INCLUDED  */
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_IDENTIFIER = 3,                 /* IDENTIFIER  */
+  YYSYMBOL_STRING = 4,                     /* STRING  */
+  YYSYMBOL_INTEGER = 5,                    /* INTEGER  */
+  YYSYMBOL_NUMBER = 6,                     /* NUMBER  */
+  YYSYMBOL_TRUE_VAL = 7,                   /* TRUE_VAL  */
+  YYSYMBOL_FALSE_VAL = 8,                  /* FALSE_VAL  */
+  YYSYMBOL_NULL_VAL = 9,                   /* NULL_VAL  */
+  YYSYMBOL_THIS = 10,                      /* THIS  */
+  YYSYMBOL_RETURN = 11,                    /* RETURN  */
+  YYSYMBOL_VAR = 12,                       /* VAR  */
+  YYSYMBOL_IF = 13,                        /* IF  */
+  YYSYMBOL_ELSE = 14,                      /* ELSE  */
+  YYSYMBOL_DO = 15,                        /* DO  */
+  YYSYMBOL_WHILE = 16,                     /* WHILE  */
+  YYSYMBOL_FOR = 17,                       /* FOR  */
+  YYSYMBOL_SWITCH = 18,                    /* SWITCH  */
+  YYSYMBOL_CASE = 19,                      /* CASE  */
+  YYSYMBOL_DEFAULT = 20,                   /* DEFAULT  */
+  YYSYMBOL_FUNCTION = 21,                  /* FUNCTION  */
+  YYSYMBOL_LCURLY = 22,                    /* LCURLY  */
+  YYSYMBOL_RCURLY = 23,                    /* RCURLY  */
+  YYSYMBOL_LPAREN = 24,                    /* LPAREN  */
+  YYSYMBOL_RPAREN = 25,                    /* RPAREN  */
+  YYSYMBOL_LSQUARE = 26,                   /* LSQUARE  */
+  YYSYMBOL_RSQUARE = 27,                   /* RSQUARE  */
+  YYSYMBOL_DOT = 28,                       /* DOT  */
+  YYSYMBOL_SEMICOLON = 29,                 /* SEMICOLON  */
+  YYSYMBOL_COMMA = 30,                     /* COMMA  */
+  YYSYMBOL_LESS_THAN = 31,                 /* LESS_THAN  */
+  YYSYMBOL_GREATER_THAN = 32,              /* GREATER_THAN  */
+  YYSYMBOL_GT_EQ = 33,                     /* GT_EQ  */
+  YYSYMBOL_LT_EQ = 34,                     /* LT_EQ  */
+  YYSYMBOL_EQ_EQ = 35,                     /* EQ_EQ  */
+  YYSYMBOL_NOT_EQ = 36,                    /* NOT_EQ  */
+  YYSYMBOL_STRICT_EQ = 37,                 /* STRICT_EQ  */
+  YYSYMBOL_NOT_STRICT_EQ = 38,             /* NOT_STRICT_EQ  */
+  YYSYMBOL_PLUS = 39,                      /* PLUS  */
+  YYSYMBOL_MINUS = 40,                     /* MINUS  */
+  YYSYMBOL_TIMES = 41,                     /* TIMES  */
+  YYSYMBOL_MOD = 42,                       /* MOD  */
+  YYSYMBOL_PLUS_PLUS = 43,                 /* PLUS_PLUS  */
+  YYSYMBOL_MINUS_MINUS = 44,               /* MINUS_MINUS  */
+  YYSYMBOL_LSHIFT = 45,                    /* LSHIFT  */
+  YYSYMBOL_RSHIFT = 46,                    /* RSHIFT  */
+  YYSYMBOL_URSHIFT = 47,                   /* URSHIFT  */
+  YYSYMBOL_BW_AND = 48,                    /* BW_AND  */
+  YYSYMBOL_BW_OR = 49,                     /* BW_OR  */
+  YYSYMBOL_XOR = 50,                       /* XOR  */
+  YYSYMBOL_NOT = 51,                       /* NOT  */
+  YYSYMBOL_BW_NOT = 52,                    /* BW_NOT  */
+  YYSYMBOL_AND = 53,                       /* AND  */
+  YYSYMBOL_OR = 54,                        /* OR  */
+  YYSYMBOL_QUESTION = 55,                  /* QUESTION  */
+  YYSYMBOL_COLON = 56,                     /* COLON  */
+  YYSYMBOL_EQUALS = 57,                    /* EQUALS  */
+  YYSYMBOL_PLUS_EQ = 58,                   /* PLUS_EQ  */
+  YYSYMBOL_MINUS_EQ = 59,                  /* MINUS_EQ  */
+  YYSYMBOL_TIMES_EQ = 60,                  /* TIMES_EQ  */
+  YYSYMBOL_MOD_EQ = 61,                    /* MOD_EQ  */
+  YYSYMBOL_LSHIFT_EQ = 62,                 /* LSHIFT_EQ  */
+  YYSYMBOL_RSHIFT_EQ = 63,                 /* RSHIFT_EQ  */
+  YYSYMBOL_URSHIFT_EQ = 64,                /* URSHIFT_EQ  */
+  YYSYMBOL_BW_AND_EQ = 65,                 /* BW_AND_EQ  */
+  YYSYMBOL_BW_OR_EQ = 66,                  /* BW_OR_EQ  */
+  YYSYMBOL_XOR_EQ = 67,                    /* XOR_EQ  */
+  YYSYMBOL_DIV = 68,                       /* DIV  */
+  YYSYMBOL_DIV_EQ = 69,                    /* DIV_EQ  */
+  YYSYMBOL_YYACCEPT = 70,                  /* $accept  */
+  YYSYMBOL_program = 71,                   /* program  */
+  YYSYMBOL_source_elements = 72,           /* source_elements  */
+  YYSYMBOL_source_element_list = 73,       /* source_element_list  */
+  YYSYMBOL_source_element = 74,            /* source_element  */
+  YYSYMBOL_statement = 75,                 /* statement  */
+  YYSYMBOL_block = 76,                     /* block  */
+  YYSYMBOL_statements = 77,                /* statements  */
+  YYSYMBOL_statement_list = 78,            /* statement_list  */
+  YYSYMBOL_var_statement = 79,             /* var_statement  */
+  YYSYMBOL_var_decls = 80,                 /* var_decls  */
+  YYSYMBOL_var_decl_list = 81,             /* var_decl_list  */
+  YYSYMBOL_var_decl = 82,                  /* var_decl  */
+  YYSYMBOL_expr_statement = 83,            /* expr_statement  */
+  YYSYMBOL_return_statement = 84,          /* return_statement  */
+  YYSYMBOL_empty_statement = 85,           /* empty_statement  */
+  YYSYMBOL_if_statement = 86,              /* if_statement  */
+  YYSYMBOL_else = 87,                      /* else  */
+  YYSYMBOL_iter_statement = 88,            /* iter_statement  */
+  YYSYMBOL_do_while_statement = 89,        /* do_while_statement  */
+  YYSYMBOL_while_statement = 90,           /* while_statement  */
+  YYSYMBOL_for_statement = 91,             /* for_statement  */
+  YYSYMBOL_first_for_expr = 92,            /* first_for_expr  */
+  YYSYMBOL_opt_expr = 93,                  /* opt_expr  */
+  YYSYMBOL_switch_statement = 94,          /* switch_statement  */
+  YYSYMBOL_case_block = 95,                /* case_block  */
+  YYSYMBOL_case_block_list = 96,           /* case_block_list  */
+  YYSYMBOL_case_clauses = 97,              /* case_clauses  */
+  YYSYMBOL_case_clause = 98,               /* case_clause  */
+  YYSYMBOL_default_clause = 99,            /* default_clause  */
+  YYSYMBOL_expr = 100,                     /* expr  */
+  YYSYMBOL_stmt_expr = 101,                /* stmt_expr  */
+  YYSYMBOL_assign_expr = 102,              /* assign_expr  */
+  YYSYMBOL_stmt_assign_expr = 103,         /* stmt_assign_expr  */
+  YYSYMBOL_assign_expr_op = 104,           /* assign_expr_op  */
+  YYSYMBOL_cond_expr = 105,                /* cond_expr  */
+  YYSYMBOL_stmt_cond_expr = 106,           /* stmt_cond_expr  */
+  YYSYMBOL_or_expr = 107,                  /* or_expr  */
+  YYSYMBOL_stmt_or_expr = 108,             /* stmt_or_expr  */
+  YYSYMBOL_and_expr = 109,                 /* and_expr  */
+  YYSYMBOL_stmt_and_expr = 110,            /* stmt_and_expr  */
+  YYSYMBOL_bw_or_expr = 111,               /* bw_or_expr  */
+  YYSYMBOL_stmt_bw_or_expr = 112,          /* stmt_bw_or_expr  */
+  YYSYMBOL_xor_expr = 113,                 /* xor_expr  */
+  YYSYMBOL_stmt_xor_expr = 114,            /* stmt_xor_expr  */
+  YYSYMBOL_bw_and_expr = 115,              /* bw_and_expr  */
+  YYSYMBOL_stmt_bw_and_expr = 116,         /* stmt_bw_and_expr  */
+  YYSYMBOL_eq_expr = 117,                  /* eq_expr  */
+  YYSYMBOL_stmt_eq_expr = 118,             /* stmt_eq_expr  */
+  YYSYMBOL_eq_expr_op = 119,               /* eq_expr_op  */
+  YYSYMBOL_neq_expr_op = 120,              /* neq_expr_op  */
+  YYSYMBOL_rel_expr = 121,                 /* rel_expr  */
+  YYSYMBOL_stmt_rel_expr = 122,            /* stmt_rel_expr  */
+  YYSYMBOL_rel_expr_op = 123,              /* rel_expr_op  */
+  YYSYMBOL_shift_expr = 124,               /* shift_expr  */
+  YYSYMBOL_stmt_shift_expr = 125,          /* stmt_shift_expr  */
+  YYSYMBOL_shift_expr_op = 126,            /* shift_expr_op  */
+  YYSYMBOL_add_expr = 127,                 /* add_expr  */
+  YYSYMBOL_stmt_add_expr = 128,            /* stmt_add_expr  */
+  YYSYMBOL_add_expr_op = 129,              /* add_expr_op  */
+  YYSYMBOL_mult_expr = 130,                /* mult_expr  */
+  YYSYMBOL_stmt_mult_expr = 131,           /* stmt_mult_expr  */
+  YYSYMBOL_mult_expr_op = 132,             /* mult_expr_op  */
+  YYSYMBOL_unary_expr = 133,               /* unary_expr  */
+  YYSYMBOL_stmt_unary_expr = 134,          /* stmt_unary_expr  */
+  YYSYMBOL_unary_expr_op = 135,            /* unary_expr_op  */
+  YYSYMBOL_postfix_expr = 136,             /* postfix_expr  */
+  YYSYMBOL_stmt_postfix_expr = 137,        /* stmt_postfix_expr  */
+  YYSYMBOL_postfix_expr_op = 138,          /* postfix_expr_op  */
+  YYSYMBOL_left_hand_expr = 139,           /* left_hand_expr  */
+  YYSYMBOL_stmt_left_hand_expr = 140,      /* stmt_left_hand_expr  */
+  YYSYMBOL_call_expr = 141,                /* call_expr  */
+  YYSYMBOL_stmt_call_expr = 142,           /* stmt_call_expr  */
+  YYSYMBOL_arguments = 143,                /* arguments  */
+  YYSYMBOL_argument_list = 144,            /* argument_list  */
+  YYSYMBOL_call_or_member_expr = 145,      /* call_or_member_expr  */
+  YYSYMBOL_stmt_call_or_member_expr = 146, /* stmt_call_or_member_expr  */
+  YYSYMBOL_new_expr = 147,                 /* new_expr  */
+  YYSYMBOL_stmt_new_expr = 148,            /* stmt_new_expr  */
+  YYSYMBOL_member_expr = 149,              /* member_expr  */
+  YYSYMBOL_stmt_member_expr = 150,         /* stmt_member_expr  */
+  YYSYMBOL_member_accessor = 151,          /* member_accessor  */
+  YYSYMBOL_function_expr = 152,            /* function_expr  */
+  YYSYMBOL_params = 153,                   /* params  */
+  YYSYMBOL_param_list = 154,               /* param_list  */
+  YYSYMBOL_primary_expr = 155,             /* primary_expr  */
+  YYSYMBOL_stmt_primary_expr = 156,        /* stmt_primary_expr  */
+  YYSYMBOL_identifier = 157,               /* identifier  */
+  YYSYMBOL_literal = 158,                  /* literal  */
+  YYSYMBOL_literal_tval = 159,             /* literal_tval  */
+  YYSYMBOL_bool_val = 160,                 /* bool_val  */
+  YYSYMBOL_object_literal = 161            /* object_literal  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* 1 */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
+      + YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  109
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   516
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  70
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  92
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  202
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  291
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   324
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
+      65,    66,    67,    68,    69
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   112,   112,   114,   115,   117,   118,   120,   122,   122,
+     122,   122,   123,   123,   123,   123,   125,   126,   128,   130,
+     131,   133,   135,   137,   138,   140,   143,   147,   149,   150,
+     152,   154,   158,   159,   161,   161,   161,   163,   167,   171,
+     176,   177,   178,   180,   181,   184,   188,   190,   190,   191,
+     192,   193,   194,   196,   197,   199,   200,   202,   203,   205,
+     206,   207,   208,   210,   211,   212,   213,   215,   216,   217,
+     218,   219,   220,   221,   222,   223,   224,   225,   226,   229,
+     230,   233,   234,   238,   239,   240,   241,   243,   244,   245,
+     246,   248,   249,   250,   251,   253,   254,   255,   256,   258,
+     259,   260,   261,   263,   264,   265,   269,   270,   271,   275,
+     276,   278,   279,   282,   283,   284,   285,   287,   288,   289,
+     290,   293,   294,   295,   296,   298,   299,   300,   303,   304,
+     305,   306,   308,   309,   312,   313,   314,   315,   317,   318,
+     319,   322,   323,   324,   325,   327,   328,   329,   330,   331,
+     332,   335,   336,   337,   338,   340,   341,   344,   344,   345,
+     345,   347,   348,   349,   350,   352,   353,   355,   356,   358,
+     358,   359,   359,   361,   362,   364,   364,   365,   366,   367,
+     369,   371,   375,   379,   380,   382,   383,   385,   385,   386,
+     386,   387,   388,   390,   394,   396,   397,   398,   399,   400,
+     402,   403,   405
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "IDENTIFIER", "STRING",
+  "INTEGER", "NUMBER", "TRUE_VAL", "FALSE_VAL", "NULL_VAL", "THIS",
+  "RETURN", "VAR", "IF", "ELSE", "DO", "WHILE", "FOR", "SWITCH", "CASE",
+  "DEFAULT", "FUNCTION", "LCURLY", "RCURLY", "LPAREN", "RPAREN", "LSQUARE",
+  "RSQUARE", "DOT", "SEMICOLON", "COMMA", "LESS_THAN", "GREATER_THAN",
+  "GT_EQ", "LT_EQ", "EQ_EQ", "NOT_EQ", "STRICT_EQ", "NOT_STRICT_EQ",
+  "PLUS", "MINUS", "TIMES", "MOD", "PLUS_PLUS", "MINUS_MINUS", "LSHIFT",
+  "RSHIFT", "URSHIFT", "BW_AND", "BW_OR", "XOR", "NOT", "BW_NOT", "AND",
+  "OR", "QUESTION", "COLON", "EQUALS", "PLUS_EQ", "MINUS_EQ", "TIMES_EQ",
+  "MOD_EQ", "LSHIFT_EQ", "RSHIFT_EQ", "URSHIFT_EQ", "BW_AND_EQ",
+  "BW_OR_EQ", "XOR_EQ", "DIV", "DIV_EQ", "$accept", "program",
+  "source_elements", "source_element_list", "source_element", "statement",
+  "block", "statements", "statement_list", "var_statement", "var_decls",
+  "var_decl_list", "var_decl", "expr_statement", "return_statement",
+  "empty_statement", "if_statement", "else", "iter_statement",
+  "do_while_statement", "while_statement", "for_statement",
+  "first_for_expr", "opt_expr", "switch_statement", "case_block",
+  "case_block_list", "case_clauses", "case_clause", "default_clause",
+  "expr", "stmt_expr", "assign_expr", "stmt_assign_expr", "assign_expr_op",
+  "cond_expr", "stmt_cond_expr", "or_expr", "stmt_or_expr", "and_expr",
+  "stmt_and_expr", "bw_or_expr", "stmt_bw_or_expr", "xor_expr",
+  "stmt_xor_expr", "bw_and_expr", "stmt_bw_and_expr", "eq_expr",
+  "stmt_eq_expr", "eq_expr_op", "neq_expr_op", "rel_expr", "stmt_rel_expr",
+  "rel_expr_op", "shift_expr", "stmt_shift_expr", "shift_expr_op",
+  "add_expr", "stmt_add_expr", "add_expr_op", "mult_expr",
+  "stmt_mult_expr", "mult_expr_op", "unary_expr", "stmt_unary_expr",
+  "unary_expr_op", "postfix_expr", "stmt_postfix_expr", "postfix_expr_op",
+  "left_hand_expr", "stmt_left_hand_expr", "call_expr", "stmt_call_expr",
+  "arguments", "argument_list", "call_or_member_expr",
+  "stmt_call_or_member_expr", "new_expr", "stmt_new_expr", "member_expr",
+  "stmt_member_expr", "member_accessor", "function_expr", "params",
+  "param_list", "primary_expr", "stmt_primary_expr", "identifier",
+  "literal", "literal_tval", "bool_val", "object_literal", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-248)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-173)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+     304,  -248,  -248,  -248,  -248,  -248,  -248,  -248,  -248,   354,
+      33,    14,   304,    24,    38,    42,   161,   464,  -248,  -248,
+    -248,  -248,  -248,  -248,  -248,    68,  -248,   304,  -248,  -248,
+    -248,  -248,  -248,  -248,  -248,  -248,  -248,  -248,  -248,  -248,
+    -248,    73,  -248,  -248,    74,    34,    43,    46,    50,    81,
+      93,    75,    94,   -19,  -248,   464,  -248,   432,    18,    90,
+    -248,    30,  -248,  -248,  -248,  -248,  -248,   106,    82,  -248,
+     108,  -248,  -248,    86,    79,    99,    92,    87,    81,    93,
+      75,    94,   -19,  -248,   464,  -248,   432,    84,    90,  -248,
+      85,  -248,  -248,  -248,  -248,    95,   121,   123,  -248,   464,
+     139,   464,   404,   464,  -248,  -248,   133,   304,    25,  -248,
+    -248,  -248,   464,   464,   464,   464,   464,   464,   464,  -248,
+    -248,  -248,  -248,   464,   464,  -248,  -248,  -248,  -248,   464,
+    -248,  -248,  -248,   464,  -248,  -248,   464,  -248,  -248,  -248,
+     464,  -248,   101,  -248,  -248,  -248,  -248,  -248,  -248,  -248,
+    -248,  -248,  -248,  -248,  -248,  -248,  -248,   464,  -248,   464,
+     155,  -248,   414,  -248,  -248,    28,   137,  -248,  -248,   464,
+     464,   464,   464,   464,   464,   464,   464,   464,   464,   464,
+     464,   464,  -248,   464,  -248,  -248,  -248,  -248,   464,  -248,
+      33,    39,   136,    51,    33,   152,   132,    52,  -248,  -248,
+    -248,  -248,    79,   126,    99,    92,    87,    81,    93,    93,
+      75,    94,   -19,  -248,  -248,    59,  -248,  -248,  -248,    54,
+    -248,  -248,    55,   304,  -248,    79,   130,    99,    92,    87,
+      81,    93,    93,    75,    94,   -19,  -248,  -248,  -248,  -248,
+     304,   464,   304,  -248,   464,   165,   464,  -248,  -248,   464,
+    -248,   185,   166,   464,   177,    58,  -248,   163,   132,   127,
+    -248,  -248,  -248,  -248,  -248,   304,  -248,   164,   464,   464,
+     138,   172,  -248,   127,  -248,   178,  -248,  -248,   171,    -5,
+     304,  -248,  -248,   178,   178,   304,   304,   304,   178,  -248,
+     304
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_uint8 yydefact[] =
+{
+       4,   193,   195,   197,   196,   200,   201,   199,   191,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    30,   145,
+     146,   149,   150,   148,   147,     0,     2,     3,     5,     7,
+       8,    10,     9,    12,    11,    13,    14,    34,    35,    36,
+      15,     0,    61,    65,    81,    85,    89,    93,    97,   101,
+     106,   115,   123,   130,   136,     0,   143,   153,   160,     0,
+     159,   174,   178,   189,   190,   194,   198,     0,     0,    29,
+       0,    59,    63,    79,    83,    87,    91,    95,    99,   103,
+     113,   121,   128,   134,     0,   141,   151,   158,     0,   157,
+     173,   176,   175,   187,   188,    25,     0,    22,    23,     0,
+       0,     0,    42,     0,    17,    19,     0,    18,     0,     1,
+       6,    27,     0,     0,     0,     0,     0,     0,     0,   109,
+     111,   110,   112,     0,     0,   117,   118,   120,   119,     0,
+     125,   126,   127,     0,   132,   133,     0,   138,   140,   139,
+       0,   144,   151,   155,   156,    67,    71,    72,    68,    70,
+      73,    74,    75,    76,    78,    77,    69,     0,   154,     0,
+       0,   164,     0,   163,   179,     0,     0,   202,    28,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,   142,     0,   152,   162,   161,   177,     0,    21,
+       0,     0,     0,     0,     0,     0,    40,     0,    16,    20,
+     192,    62,    86,     0,    90,    94,    98,   102,   107,   108,
+     116,   124,   131,   137,    66,     0,   181,   165,   167,     0,
+     185,   183,     0,     4,    60,    84,     0,    88,    92,    96,
+     100,   104,   105,   114,   122,   129,   135,    64,    26,    24,
+       0,     0,     0,    41,    44,     0,     0,   180,   166,     0,
+     184,     0,     0,     0,    33,     0,    38,     0,    43,    52,
+      82,   168,   186,   182,    80,     0,    31,     0,    44,     0,
+       0,     0,    46,    47,    53,    48,    32,    37,     0,     0,
+      58,    45,    54,    49,    50,     0,    56,    57,    51,    39,
+      55
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+    -248,  -248,   -25,  -248,   175,    16,  -248,  -248,  -247,  -248,
+       5,  -248,    13,  -248,  -248,  -248,  -248,  -248,  -248,  -248,
+    -248,  -248,  -248,   -62,  -248,  -248,  -248,  -246,  -243,   -66,
+      -2,  -248,  -110,  -248,   122,  -248,  -248,  -248,  -248,  -107,
+    -248,  -112,  -248,  -106,  -248,  -104,  -248,  -101,  -248,   160,
+     162,  -105,  -248,   167,  -103,  -248,   159,  -122,  -248,   168,
+    -115,  -248,   169,   -50,  -248,     0,  -248,  -248,   157,    -8,
+    -248,  -248,  -248,   128,  -248,  -248,  -248,  -248,  -248,  -248,
+    -248,   -47,  -248,  -248,  -248,  -248,     8,    61,  -248,  -248,
+    -248,  -248
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int16 yydefgoto[] =
+{
+       0,    25,    26,    27,    28,    29,    30,   106,   107,    31,
+      96,    97,    98,    32,    33,    34,    35,   266,    36,    37,
+      38,    39,   195,   257,    40,   271,   272,   273,   274,   275,
+     258,    41,    71,    42,   157,    72,    43,    73,    44,    74,
+      45,    75,    46,    76,    47,    77,    48,    78,    49,   176,
+     177,    79,    50,   178,    80,    51,   179,    81,    52,   180,
+      82,    53,   181,    83,    54,    84,    85,    56,   184,   142,
+      57,    87,    58,   163,   219,    88,    59,    89,    60,    90,
+      61,   161,    91,   166,   222,    92,    93,    63,    64,    65,
+      66,    94
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+      55,    86,   201,   204,   203,   141,   202,    70,    62,    86,
+     205,   211,    55,   206,   164,   108,    55,   207,   208,   209,
+      62,   212,   137,   138,    62,   169,   210,    55,   100,   284,
+     282,   220,   105,   287,   182,    62,    95,   288,    99,   290,
+     185,   282,  -172,   187,   159,   282,   160,   214,   101,   139,
+     200,   286,   218,   221,  -171,   169,   159,   234,   160,   224,
+     227,   226,   102,   225,   240,   235,   103,   228,   109,   169,
+     229,   231,   232,   237,   230,   233,   242,   245,   238,   248,
+     250,   169,   169,   267,   249,   251,   247,   115,   169,   169,
+     213,    86,   116,    86,    86,    86,   117,   191,   118,   193,
+     196,   197,   111,   112,    86,   167,    86,    55,  -170,  -169,
+     159,   159,   160,   160,   162,    62,   119,   120,   121,   122,
+     130,   131,   132,   199,   125,   126,   127,   128,   113,   114,
+     165,   236,   172,   134,   135,   175,   260,   168,   169,   261,
+     170,   171,   174,   264,   143,   144,   269,   270,   173,    86,
+     189,    86,   188,   190,    86,   192,   198,   215,     1,   223,
+     241,    86,   169,    86,     1,     2,     3,     4,     5,     6,
+       7,     8,     9,    10,    11,    86,    12,    13,    14,    15,
+      86,   244,   246,    16,   104,    17,   253,   259,   262,   263,
+      18,   265,   268,   277,   280,   281,   285,   269,   252,   243,
+      19,    20,   110,   239,    21,    22,   278,   283,   183,   123,
+     133,   124,    23,    24,   158,     0,   186,   129,     0,     0,
+     136,   216,   140,    55,     0,     0,     0,     0,     0,     0,
+       0,    62,     0,    86,     0,     0,    86,     0,    86,   255,
+      55,    86,    55,     0,     0,    86,     0,     0,    62,     0,
+      62,     0,     0,     0,     0,     0,   254,     0,   256,     0,
+      86,    86,     0,     0,     0,    55,     0,   279,     0,     0,
+       0,     0,     0,    62,     0,     0,     0,     0,     0,     0,
+      55,   276,     0,     0,     0,    55,    55,    55,    62,     0,
+      55,     0,     0,    62,    62,    62,   105,     0,    62,     0,
+       0,   289,   105,   199,     0,     0,   199,     1,     2,     3,
+       4,     5,     6,     7,     8,     9,    10,    11,     0,    12,
+      13,    14,    15,     0,     0,     0,    16,     0,    17,     0,
+       0,     0,     0,    18,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    19,    20,     0,     0,    21,    22,     0,
+       0,     0,     0,     0,     0,    23,    24,     1,     2,     3,
+       4,     5,     6,     7,     8,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    67,    68,     0,    17,     0,
+       0,     0,     0,    69,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    19,    20,     0,     0,    21,    22,     0,
+       0,     0,     0,     0,     0,    23,    24,     1,     2,     3,
+       4,     5,     6,     7,     8,     0,   194,     1,     2,     3,
+       4,     5,     6,     7,     8,    67,    68,     0,    17,     0,
+       0,     0,     0,     0,     0,    67,    68,     0,    17,   217,
+       0,     0,     0,    19,    20,     0,     0,    21,    22,     0,
+       0,     0,     0,    19,    20,    23,    24,    21,    22,     0,
+       0,     0,     0,     0,     0,    23,    24,     1,     2,     3,
+       4,     5,     6,     7,     8,   143,   144,     0,     0,     0,
+       0,     0,     0,     0,     0,    67,    68,     0,    17,   145,
+     146,   147,   148,   149,   150,   151,   152,   153,   154,   155,
+       0,   156,     0,    19,    20,     0,     0,    21,    22,     0,
+       0,     0,     0,     0,     0,    23,    24
+};
+
+static const yytype_int16 yycheck[] =
+{
+       0,     9,   112,   115,   114,    55,   113,     9,     0,    17,
+     116,   133,    12,   117,    61,    17,    16,   118,   123,   124,
+      12,   136,    41,    42,    16,    30,   129,    27,    12,   275,
+     273,     3,    16,   280,    84,    27,     3,   283,    24,   286,
+      87,   284,    24,    90,    26,   288,    28,   157,    24,    68,
+      25,    56,   162,    25,    24,    30,    26,   179,    28,   169,
+     172,   171,    24,   170,    25,   180,    24,   173,     0,    30,
+     174,   176,   177,   183,   175,   178,    25,    25,   188,    25,
+      25,    30,    30,    25,    30,    30,    27,    53,    30,    30,
+     140,    99,    49,   101,   102,   103,    50,    99,    48,   101,
+     102,   103,    29,    30,   112,    23,   114,   107,    24,    24,
+      26,    26,    28,    28,    24,   107,    35,    36,    37,    38,
+      45,    46,    47,   107,    31,    32,    33,    34,    54,    55,
+      24,   181,    53,    39,    40,    48,   246,    29,    30,   249,
+      54,    55,    50,   253,    43,    44,    19,    20,    49,   157,
+      29,   159,    57,    30,   162,    16,    23,   159,     3,    22,
+      24,   169,    30,   171,     3,     4,     5,     6,     7,     8,
+       9,    10,    11,    12,    13,   183,    15,    16,    17,    18,
+     188,    29,    56,    22,    23,    24,    56,    22,     3,    23,
+      29,    14,    29,    29,    56,    23,    25,    19,   223,   194,
+      39,    40,    27,   190,    43,    44,   268,   273,    86,    49,
+      51,    49,    51,    52,    57,    -1,    88,    50,    -1,    -1,
+      52,   160,    53,   223,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,   223,    -1,   241,    -1,    -1,   244,    -1,   246,   241,
+     240,   249,   242,    -1,    -1,   253,    -1,    -1,   240,    -1,
+     242,    -1,    -1,    -1,    -1,    -1,   240,    -1,   242,    -1,
+     268,   269,    -1,    -1,    -1,   265,    -1,   269,    -1,    -1,
+      -1,    -1,    -1,   265,    -1,    -1,    -1,    -1,    -1,    -1,
+     280,   265,    -1,    -1,    -1,   285,   286,   287,   280,    -1,
+     290,    -1,    -1,   285,   286,   287,   280,    -1,   290,    -1,
+      -1,   285,   286,   287,    -1,    -1,   290,     3,     4,     5,
+       6,     7,     8,     9,    10,    11,    12,    13,    -1,    15,
+      16,    17,    18,    -1,    -1,    -1,    22,    -1,    24,    -1,
+      -1,    -1,    -1,    29,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    39,    40,    -1,    -1,    43,    44,    -1,
+      -1,    -1,    -1,    -1,    -1,    51,    52,     3,     4,     5,
+       6,     7,     8,     9,    10,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    21,    22,    -1,    24,    -1,
+      -1,    -1,    -1,    29,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    39,    40,    -1,    -1,    43,    44,    -1,
+      -1,    -1,    -1,    -1,    -1,    51,    52,     3,     4,     5,
+       6,     7,     8,     9,    10,    -1,    12,     3,     4,     5,
+       6,     7,     8,     9,    10,    21,    22,    -1,    24,    -1,
+      -1,    -1,    -1,    -1,    -1,    21,    22,    -1,    24,    25,
+      -1,    -1,    -1,    39,    40,    -1,    -1,    43,    44,    -1,
+      -1,    -1,    -1,    39,    40,    51,    52,    43,    44,    -1,
+      -1,    -1,    -1,    -1,    -1,    51,    52,     3,     4,     5,
+       6,     7,     8,     9,    10,    43,    44,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    21,    22,    -1,    24,    57,
+      58,    59,    60,    61,    62,    63,    64,    65,    66,    67,
+      -1,    69,    -1,    39,    40,    -1,    -1,    43,    44,    -1,
+      -1,    -1,    -1,    -1,    -1,    51,    52
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_uint8 yystos[] =
+{
+       0,     3,     4,     5,     6,     7,     8,     9,    10,    11,
+      12,    13,    15,    16,    17,    18,    22,    24,    29,    39,
+      40,    43,    44,    51,    52,    71,    72,    73,    74,    75,
+      76,    79,    83,    84,    85,    86,    88,    89,    90,    91,
+      94,   101,   103,   106,   108,   110,   112,   114,   116,   118,
+     122,   125,   128,   131,   134,   135,   137,   140,   142,   146,
+     148,   150,   156,   157,   158,   159,   160,    21,    22,    29,
+     100,   102,   105,   107,   109,   111,   113,   115,   117,   121,
+     124,   127,   130,   133,   135,   136,   139,   141,   145,   147,
+     149,   152,   155,   156,   161,     3,    80,    81,    82,    24,
+      75,    24,    24,    24,    23,    75,    77,    78,   100,     0,
+      74,    29,    30,    54,    55,    53,    49,    50,    48,    35,
+      36,    37,    38,   119,   120,    31,    32,    33,    34,   123,
+      45,    46,    47,   126,    39,    40,   129,    41,    42,    68,
+     132,   133,   139,    43,    44,    57,    58,    59,    60,    61,
+      62,    63,    64,    65,    66,    67,    69,   104,   138,    26,
+      28,   151,    24,   143,   151,    24,   153,    23,    29,    30,
+      54,    55,    53,    49,    50,    48,   119,   120,   123,   126,
+     129,   132,   133,   104,   138,   151,   143,   151,    57,    29,
+      30,   100,    16,   100,    12,    92,   100,   100,    23,    75,
+      25,   102,   109,   102,   111,   113,   115,   117,   121,   121,
+     124,   127,   130,   133,   102,   100,   157,    25,   102,   144,
+       3,    25,   154,    22,   102,   109,   102,   111,   113,   115,
+     117,   121,   121,   124,   127,   130,   133,   102,   102,    82,
+      25,    24,    25,    80,    29,    25,    56,    27,    25,    30,
+      25,    30,    72,    56,    75,   100,    75,    93,   100,    22,
+     102,   102,     3,    23,   102,    14,    87,    25,    29,    19,
+      20,    95,    96,    97,    98,    99,    75,    29,    93,   100,
+      56,    23,    98,    99,    97,    25,    56,    78,    97,    75,
+      78
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_uint8 yyr1[] =
+{
+       0,    70,    71,    72,    72,    73,    73,    74,    75,    75,
+      75,    75,    75,    75,    75,    75,    76,    76,    77,    78,
+      78,    79,    80,    81,    81,    82,    82,    83,    84,    84,
+      85,    86,    87,    87,    88,    88,    88,    89,    90,    91,
+      92,    92,    92,    93,    93,    94,    95,    96,    96,    96,
+      96,    96,    96,    97,    97,    98,    98,    99,    99,   100,
+     100,   101,   101,   102,   102,   103,   103,   104,   104,   104,
+     104,   104,   104,   104,   104,   104,   104,   104,   104,   105,
+     105,   106,   106,   107,   107,   108,   108,   109,   109,   110,
+     110,   111,   111,   112,   112,   113,   113,   114,   114,   115,
+     115,   116,   116,   117,   117,   117,   118,   118,   118,   119,
+     119,   120,   120,   121,   121,   122,   122,   123,   123,   123,
+     123,   124,   124,   125,   125,   126,   126,   126,   127,   127,
+     128,   128,   129,   129,   130,   130,   131,   131,   132,   132,
+     132,   133,   133,   134,   134,   135,   135,   135,   135,   135,
+     135,   136,   136,   137,   137,   138,   138,   139,   139,   140,
+     140,   141,   141,   142,   142,   143,   143,   144,   144,   145,
+     145,   146,   146,   147,   148,   149,   149,   149,   150,   150,
+     151,   151,   152,   153,   153,   154,   154,   155,   155,   156,
+     156,   156,   156,   157,   158,   159,   159,   159,   159,   159,
+     160,   160,   161
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     1,     0,     1,     2,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     3,     2,     1,     1,
+       2,     3,     1,     1,     3,     1,     3,     2,     3,     2,
+       1,     6,     2,     0,     1,     1,     1,     7,     5,     9,
+       1,     2,     0,     1,     0,     7,     1,     1,     1,     2,
+       2,     3,     0,     1,     2,     4,     3,     3,     2,     1,
+       3,     1,     3,     1,     3,     1,     3,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       5,     1,     5,     1,     3,     1,     3,     1,     3,     1,
+       3,     1,     3,     1,     3,     1,     3,     1,     3,     1,
+       3,     1,     3,     1,     3,     3,     1,     3,     3,     1,
+       1,     1,     1,     1,     3,     1,     3,     1,     1,     1,
+       1,     1,     3,     1,     3,     1,     1,     1,     1,     3,
+       1,     3,     1,     1,     1,     3,     1,     3,     1,     1,
+       1,     1,     2,     1,     2,     1,     1,     1,     1,     1,
+       1,     1,     2,     1,     2,     1,     1,     1,     1,     1,
+       1,     2,     2,     2,     2,     2,     3,     1,     3,     1,
+       1,     1,     1,     1,     1,     1,     1,     2,     1,     2,
+       3,     2,     5,     2,     3,     1,     3,     1,     1,     1,
+       1,     1,     3,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     2
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (jz, root, state, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, jz, root, state); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, jz_state* jz, jz_cons** root, jz_lex_state* state)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (jz);
+  YY_USE (root);
+  YY_USE (state);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, jz_state* jz, jz_cons** root, jz_lex_state* state)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep, jz, root, state);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, jz_state* jz, jz_cons** root, jz_lex_state* state)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], jz, root, state);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule, jz, root, state); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
+/* Return the length of YYSTR.  */
+static YYPTRDIFF_T
+yystrlen (const char *yystr)
+{
+  YYPTRDIFF_T yylen;
+  for (yylen = 0; yystr[yylen]; yylen++)
+    continue;
+  return yylen;
+}
+# endif
+#endif
+
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
+/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
+   YYDEST.  */
+static char *
+yystpcpy (char *yydest, const char *yysrc)
+{
+  char *yyd = yydest;
+  const char *yys = yysrc;
+
+  while ((*yyd++ = *yys++) != '\0')
+    continue;
+
+  return yyd - 1;
+}
+# endif
+#endif
+
+#ifndef yytnamerr
+/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
+   quotes and backslashes, so that it's suitable for yyerror.  The
+   heuristic is that double-quoting is unnecessary unless the string
+   contains an apostrophe, a comma, or backslash (other than
+   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
+   null, do not copy; instead, return the length of what the result
+   would have been.  */
+static YYPTRDIFF_T
+yytnamerr (char *yyres, const char *yystr)
+{
+  if (*yystr == '"')
+    {
+      YYPTRDIFF_T yyn = 0;
+      char const *yyp = yystr;
+      for (;;)
+        switch (*++yyp)
+          {
+          case '\'':
+          case ',':
+            goto do_not_strip_quotes;
+
+          case '\\':
+            if (*++yyp != '\\')
+              goto do_not_strip_quotes;
+            else
+              goto append;
+
+          append:
+          default:
+            if (yyres)
+              yyres[yyn] = *yyp;
+            yyn++;
+            break;
+
+          case '"':
+            if (yyres)
+              yyres[yyn] = '\0';
+            return yyn;
+          }
+    do_not_strip_quotes: ;
+    }
+
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
+    return yystrlen (yystr);
+}
+#endif
+
+
+static int
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  /* There are many possibilities here to consider:
+     - If this state is a consistent state with a default action, then
+       the only way this function was invoked is if the default action
+       is an error action.  In that case, don't check for expected
+       tokens because there are none.
+     - The only way there can be no lookahead present (in yychar) is if
+       this state is a consistent state with a default action.  Thus,
+       detecting the absence of a lookahead is sufficient to determine
+       that there is no unexpected or expected token to report.  In that
+       case, just report a simple "syntax error".
+     - Don't assume there isn't a lookahead just because this state is a
+       consistent state with a default action.  There might have been a
+       previous inconsistent state, consistent state with a non-default
+       action, or user semantic action that manipulated yychar.
+     - Of course, the expected token list depends on states to have
+       correct lookahead information, and it depends on the parser not
+       to perform extra reductions after fetching a lookahead from the
+       scanner and before detecting a syntax error.  Thus, state merging
+       (from LALR or IELR) and default reductions corrupt the expected
+       token list.  However, the list is correct for canonical LR with
+       one exception: it will still contain any token that will not be
+       accepted due to an error action in a later state.
+  */
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
+    }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
+
+  switch (yycount)
+    {
+#define YYCASE_(N, S)                       \
+      case N:                               \
+        yyformat = S;                       \
+        break
+    default: /* Avoid compiler warnings. */
+      YYCASE_(0, YY_("syntax error"));
+      YYCASE_(1, YY_("syntax error, unexpected %s"));
+      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
+      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
+      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
+      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
+#undef YYCASE_
+    }
+
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
+  {
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
+  }
+
+  if (*yymsg_alloc < yysize)
+    {
+      *yymsg_alloc = 2 * yysize;
+      if (! (yysize <= *yymsg_alloc
+             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
+        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
+      return -1;
+    }
+
+  /* Avoid sprintf, as that infringes on the user's name space.
+     Don't have undefined behavior even if the translation
+     produced a string with the wrong number of "%s"s.  */
+  {
+    char *yyp = *yymsg;
+    int yyi = 0;
+    while ((*yyp = *yyformat) != '\0')
+      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
+        {
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
+          yyformat += 2;
+        }
+      else
+        {
+          ++yyp;
+          ++yyformat;
+        }
+  }
+  return 0;
+}
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, jz_state* jz, jz_cons** root, jz_lex_state* state)
+{
+  YY_USE (yyvaluep);
+  YY_USE (jz);
+  YY_USE (root);
+  YY_USE (state);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (jz_state* jz, jz_cons** root, jz_lex_state* state)
+{
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+
+  /* Buffer for error messages, and its allocated size.  */
+  char yymsgbuf[128];
+  char *yymsg = yymsgbuf;
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, jz, state);
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 2: /* program: source_elements  */
+#line 112 "parse.y"
+                         { *root = (yyvsp[0].node); }
+#line 2011 "y.tab.c"
+    break;
+
+  case 3: /* source_elements: source_element_list  */
+#line 114 "parse.y"
+                                     { (yyval.node) = jz_list_reverse(jz, (yyvsp[0].node)); }
+#line 2017 "y.tab.c"
+    break;
+
+  case 4: /* source_elements: %empty  */
+#line 115 "parse.y"
+                { (yyval.node) = NULL; }
+#line 2023 "y.tab.c"
+    break;
+
+  case 5: /* source_element_list: source_element  */
+#line 117 "parse.y"
+                                    { (yyval.node) = CONS((yyvsp[0].node), NULL); }
+#line 2029 "y.tab.c"
+    break;
+
+  case 6: /* source_element_list: source_element_list source_element  */
+#line 118 "parse.y"
+                                       { (yyval.node) = CONS((yyvsp[0].node), (yyvsp[-1].node)); }
+#line 2035 "y.tab.c"
+    break;
+
+  case 16: /* block: LCURLY statements RCURLY  */
+#line 125 "parse.y"
+                                { (yyval.node) = CONS(jz_enum_new(jz, jz_parse_block), (yyvsp[-1].node)); }
+#line 2041 "y.tab.c"
+    break;
+
+  case 17: /* block: LCURLY RCURLY  */
+#line 126 "parse.y"
+                  { (yyval.node) = NULL; }
+#line 2047 "y.tab.c"
+    break;
+
+  case 18: /* statements: statement_list  */
+#line 128 "parse.y"
+                           { (yyval.node) = jz_list_reverse(jz, (yyvsp[0].node)); }
+#line 2053 "y.tab.c"
+    break;
+
+  case 19: /* statement_list: statement  */
+#line 130 "parse.y"
+                          { (yyval.node) = CONS((yyvsp[0].node), NULL); }
+#line 2059 "y.tab.c"
+    break;
+
+  case 20: /* statement_list: statement_list statement  */
+#line 131 "parse.y"
+                             { (yyval.node) = CONS((yyvsp[0].node), (yyvsp[-1].node)); }
+#line 2065 "y.tab.c"
+    break;
+
+  case 21: /* var_statement: VAR var_decls SEMICOLON  */
+#line 133 "parse.y"
+                                       { (yyval.node) = (yyvsp[-1].node); }
+#line 2071 "y.tab.c"
+    break;
+
+  case 22: /* var_decls: var_decl_list  */
+#line 135 "parse.y"
+                         { (yyval.node) = CONS(jz_enum_new(jz, jz_parse_var), jz_list_reverse(jz, (yyvsp[0].node))); }
+#line 2077 "y.tab.c"
+    break;
+
+  case 23: /* var_decl_list: var_decl  */
+#line 137 "parse.y"
+                        { (yyval.node) = CONS((yyvsp[0].node), NULL); }
+#line 2083 "y.tab.c"
+    break;
+
+  case 24: /* var_decl_list: var_decl_list COMMA var_decl  */
+#line 138 "parse.y"
+                                 { (yyval.node) = CONS((yyvsp[0].node), (yyvsp[-2].node)); }
+#line 2089 "y.tab.c"
+    break;
+
+  case 25: /* var_decl: IDENTIFIER  */
+#line 140 "parse.y"
+                     {
+  (yyval.node) = jz_list(jz, 2, (yyvsp[0].str), NULL);
+ }
+#line 2097 "y.tab.c"
+    break;
+
+  case 26: /* var_decl: IDENTIFIER EQUALS assign_expr  */
+#line 143 "parse.y"
+                                  {
+    (yyval.node) = jz_list(jz, 2, (yyvsp[-2].str), (yyvsp[0].node));
+ }
+#line 2105 "y.tab.c"
+    break;
+
+  case 27: /* expr_statement: stmt_expr SEMICOLON  */
+#line 147 "parse.y"
+                                    { (yyval.node) = CONS(jz_enum_new(jz, jz_parse_expr), (yyvsp[-1].node)); }
+#line 2111 "y.tab.c"
+    break;
+
+  case 28: /* return_statement: RETURN expr SEMICOLON  */
+#line 149 "parse.y"
+                                        { (yyval.node) = jz_enum_wrap(jz, jz_parse_return, (yyvsp[-1].node)); }
+#line 2117 "y.tab.c"
+    break;
+
+  case 29: /* return_statement: RETURN SEMICOLON  */
+#line 150 "parse.y"
+                     { (yyval.node) = jz_enum_wrap(jz, jz_parse_return, NULL); }
+#line 2123 "y.tab.c"
+    break;
+
+  case 30: /* empty_statement: SEMICOLON  */
+#line 152 "parse.y"
+                           { (yyval.node) = NULL; }
+#line 2129 "y.tab.c"
+    break;
+
+  case 31: /* if_statement: IF LPAREN expr RPAREN statement else  */
+#line 154 "parse.y"
+                                                   {
+   (yyval.node) = jz_list(jz, 4, jz_enum_new(jz, jz_parse_if), (yyvsp[-3].node), (yyvsp[-1].node), (yyvsp[0].node));
+ }
+#line 2137 "y.tab.c"
+    break;
+
+  case 32: /* else: ELSE statement  */
+#line 158 "parse.y"
+                     { (yyval.node) = (yyvsp[0].node); }
+#line 2143 "y.tab.c"
+    break;
+
+  case 33: /* else: %empty  */
+#line 159 "parse.y"
+                { (yyval.node) = NULL; }
+#line 2149 "y.tab.c"
+    break;
+
+  case 37: /* do_while_statement: DO statement WHILE LPAREN expr RPAREN SEMICOLON  */
+#line 163 "parse.y"
+                                                                    {
+  (yyval.node) = jz_list(jz, 3, jz_enum_new(jz, jz_parse_do_while), (yyvsp[-2].node), (yyvsp[-5].node));
+ }
+#line 2157 "y.tab.c"
+    break;
+
+  case 38: /* while_statement: WHILE LPAREN expr RPAREN statement  */
+#line 167 "parse.y"
+                                                    {
+  (yyval.node) = jz_list(jz, 3, jz_enum_new(jz, jz_parse_while), (yyvsp[-2].node), (yyvsp[0].node));
+ }
+#line 2165 "y.tab.c"
+    break;
+
+  case 39: /* for_statement: FOR LPAREN first_for_expr SEMICOLON opt_expr SEMICOLON opt_expr RPAREN statement  */
+#line 172 "parse.y"
+                                                 {
+      (yyval.node) = jz_list(jz, 5, jz_enum_new(jz, jz_parse_for), (yyvsp[-6].node), (yyvsp[-4].node), (yyvsp[-2].node), (yyvsp[0].node));
+ }
+#line 2173 "y.tab.c"
+    break;
+
+  case 40: /* first_for_expr: expr  */
+#line 176 "parse.y"
+                     { (yyval.node) = CONS(jz_enum_new(jz, jz_parse_expr), (yyvsp[0].node)); }
+#line 2179 "y.tab.c"
+    break;
+
+  case 41: /* first_for_expr: VAR var_decls  */
+#line 177 "parse.y"
+                  { (yyval.node) = (yyvsp[0].node); }
+#line 2185 "y.tab.c"
+    break;
+
+  case 42: /* first_for_expr: %empty  */
+#line 178 "parse.y"
+                { (yyval.node) = NULL; }
+#line 2191 "y.tab.c"
+    break;
+
+  case 44: /* opt_expr: %empty  */
+#line 181 "parse.y"
+                { (yyval.node) = NULL; }
+#line 2197 "y.tab.c"
+    break;
+
+  case 45: /* switch_statement: SWITCH LPAREN expr RPAREN LCURLY case_block RCURLY  */
+#line 184 "parse.y"
+                                                                     {
+  (yyval.node) = CONS(jz_enum_new(jz, jz_parse_switch), CONS((yyvsp[-4].node), (yyvsp[-1].node)));
+ }
+#line 2205 "y.tab.c"
+    break;
+
+  case 46: /* case_block: case_block_list  */
+#line 188 "parse.y"
+                            { (yyval.node) = jz_list_reverse(jz, (yyvsp[0].node)); }
+#line 2211 "y.tab.c"
+    break;
+
+  case 49: /* case_block_list: case_clauses default_clause  */
+#line 191 "parse.y"
+                                { (yyval.node) = jz_list_concat(jz, (yyvsp[0].node), (yyvsp[-1].node)); }
+#line 2217 "y.tab.c"
+    break;
+
+  case 50: /* case_block_list: default_clause case_clauses  */
+#line 192 "parse.y"
+                                { (yyval.node) = jz_list_concat(jz, (yyvsp[0].node), (yyvsp[-1].node)); }
+#line 2223 "y.tab.c"
+    break;
+
+  case 51: /* case_block_list: case_clauses default_clause case_clauses  */
+#line 193 "parse.y"
+                                             { (yyval.node) = jz_list_concat(jz, jz_list_concat(jz, (yyvsp[0].node), (yyvsp[-1].node)), (yyvsp[-2].node)); }
+#line 2229 "y.tab.c"
+    break;
+
+  case 52: /* case_block_list: %empty  */
+#line 194 "parse.y"
+                { (yyval.node) = NULL; }
+#line 2235 "y.tab.c"
+    break;
+
+  case 53: /* case_clauses: case_clause  */
+#line 196 "parse.y"
+                          { (yyval.node) = CONS((yyvsp[0].node), NULL); }
+#line 2241 "y.tab.c"
+    break;
+
+  case 54: /* case_clauses: case_clauses case_clause  */
+#line 197 "parse.y"
+                             { (yyval.node) = CONS((yyvsp[0].node), (yyvsp[-1].node)); }
+#line 2247 "y.tab.c"
+    break;
+
+  case 55: /* case_clause: CASE expr COLON statement_list  */
+#line 199 "parse.y"
+                                            { (yyval.node) = CONS((yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2253 "y.tab.c"
+    break;
+
+  case 56: /* case_clause: CASE expr COLON  */
+#line 200 "parse.y"
+                    { (yyval.node) = CONS((yyvsp[-1].node), NULL); }
+#line 2259 "y.tab.c"
+    break;
+
+  case 57: /* default_clause: DEFAULT COLON statement_list  */
+#line 202 "parse.y"
+                                             { (yyval.node) = CONS(CONS(NULL, (yyvsp[0].node)), NULL); }
+#line 2265 "y.tab.c"
+    break;
+
+  case 58: /* default_clause: DEFAULT COLON  */
+#line 203 "parse.y"
+                  { (yyval.node) = CONS(CONS(NULL, NULL), NULL); }
+#line 2271 "y.tab.c"
+    break;
+
+  case 60: /* expr: expr COMMA assign_expr  */
+#line 206 "parse.y"
+                           { (yyval.node) = binop_node(jz, jz_op_comma, (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2277 "y.tab.c"
+    break;
+
+  case 62: /* stmt_expr: stmt_expr COMMA assign_expr  */
+#line 208 "parse.y"
+                                { (yyval.node) = binop_node(jz, jz_op_comma, (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2283 "y.tab.c"
+    break;
+
+  case 64: /* assign_expr: left_hand_expr assign_expr_op assign_expr  */
+#line 211 "parse.y"
+                                              { (yyval.node) = binop_node(jz, (yyvsp[-1].operation), (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2289 "y.tab.c"
+    break;
+
+  case 66: /* stmt_assign_expr: stmt_left_hand_expr assign_expr_op assign_expr  */
+#line 213 "parse.y"
+                                                   { (yyval.node) = binop_node(jz, (yyvsp[-1].operation), (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2295 "y.tab.c"
+    break;
+
+  case 67: /* assign_expr_op: EQUALS  */
+#line 215 "parse.y"
+                       { (yyval.operation) = jz_op_assign; }
+#line 2301 "y.tab.c"
+    break;
+
+  case 68: /* assign_expr_op: TIMES_EQ  */
+#line 216 "parse.y"
+               { (yyval.operation) = jz_op_times_eq; }
+#line 2307 "y.tab.c"
+    break;
+
+  case 69: /* assign_expr_op: DIV_EQ  */
+#line 217 "parse.y"
+               { (yyval.operation) = jz_op_div_eq; }
+#line 2313 "y.tab.c"
+    break;
+
+  case 70: /* assign_expr_op: MOD_EQ  */
+#line 218 "parse.y"
+               { (yyval.operation) = jz_op_mod_eq; }
+#line 2319 "y.tab.c"
+    break;
+
+  case 71: /* assign_expr_op: PLUS_EQ  */
+#line 219 "parse.y"
+               { (yyval.operation) = jz_op_add_eq; }
+#line 2325 "y.tab.c"
+    break;
+
+  case 72: /* assign_expr_op: MINUS_EQ  */
+#line 220 "parse.y"
+               { (yyval.operation) = jz_op_sub_eq; }
+#line 2331 "y.tab.c"
+    break;
+
+  case 73: /* assign_expr_op: LSHIFT_EQ  */
+#line 221 "parse.y"
+               { (yyval.operation) = jz_op_lshift_eq; }
+#line 2337 "y.tab.c"
+    break;
+
+  case 74: /* assign_expr_op: RSHIFT_EQ  */
+#line 222 "parse.y"
+               { (yyval.operation) = jz_op_rshift_eq; }
+#line 2343 "y.tab.c"
+    break;
+
+  case 75: /* assign_expr_op: URSHIFT_EQ  */
+#line 223 "parse.y"
+               { (yyval.operation) = jz_op_urshift_eq; }
+#line 2349 "y.tab.c"
+    break;
+
+  case 76: /* assign_expr_op: BW_AND_EQ  */
+#line 224 "parse.y"
+               { (yyval.operation) = jz_op_bw_and_eq; }
+#line 2355 "y.tab.c"
+    break;
+
+  case 77: /* assign_expr_op: XOR_EQ  */
+#line 225 "parse.y"
+               { (yyval.operation) = jz_op_xor_eq; }
+#line 2361 "y.tab.c"
+    break;
+
+  case 78: /* assign_expr_op: BW_OR_EQ  */
+#line 226 "parse.y"
+               { (yyval.operation) = jz_op_bw_or_eq; }
+#line 2367 "y.tab.c"
+    break;
+
+  case 80: /* cond_expr: or_expr QUESTION assign_expr COLON assign_expr  */
+#line 230 "parse.y"
+                                                   {
+    (yyval.node) = jz_list(jz, 4, jz_enum_new(jz, jz_parse_cond), (yyvsp[-4].node), (yyvsp[-2].node), (yyvsp[0].node));
+ }
+#line 2375 "y.tab.c"
+    break;
+
+  case 82: /* stmt_cond_expr: stmt_or_expr QUESTION assign_expr COLON assign_expr  */
+#line 234 "parse.y"
+                                                        {
+    (yyval.node) = jz_list(jz, 4, jz_enum_new(jz, jz_parse_cond), (yyvsp[-4].node), (yyvsp[-2].node), (yyvsp[0].node));
+ }
+#line 2383 "y.tab.c"
+    break;
+
+  case 84: /* or_expr: or_expr OR and_expr  */
+#line 239 "parse.y"
+                        { (yyval.node) = binop_node(jz, jz_op_or, (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2389 "y.tab.c"
+    break;
+
+  case 86: /* stmt_or_expr: stmt_or_expr OR and_expr  */
+#line 241 "parse.y"
+                             { (yyval.node) = binop_node(jz, jz_op_or, (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2395 "y.tab.c"
+    break;
+
+  case 88: /* and_expr: and_expr AND bw_or_expr  */
+#line 244 "parse.y"
+                            { (yyval.node) = binop_node(jz, jz_op_and, (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2401 "y.tab.c"
+    break;
+
+  case 90: /* stmt_and_expr: stmt_and_expr AND bw_or_expr  */
+#line 246 "parse.y"
+                                 { (yyval.node) = binop_node(jz, jz_op_and, (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2407 "y.tab.c"
+    break;
+
+  case 92: /* bw_or_expr: bw_or_expr BW_OR xor_expr  */
+#line 249 "parse.y"
+                              { (yyval.node) = binop_node(jz, jz_op_bw_or, (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2413 "y.tab.c"
+    break;
+
+  case 94: /* stmt_bw_or_expr: stmt_bw_or_expr BW_OR xor_expr  */
+#line 251 "parse.y"
+                                   { (yyval.node) = binop_node(jz, jz_op_bw_or, (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2419 "y.tab.c"
+    break;
+
+  case 96: /* xor_expr: xor_expr XOR bw_and_expr  */
+#line 254 "parse.y"
+                             { (yyval.node) = binop_node(jz, jz_op_xor, (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2425 "y.tab.c"
+    break;
+
+  case 98: /* stmt_xor_expr: stmt_xor_expr XOR bw_and_expr  */
+#line 256 "parse.y"
+                                  { (yyval.node) = binop_node(jz, jz_op_xor, (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2431 "y.tab.c"
+    break;
+
+  case 100: /* bw_and_expr: bw_and_expr BW_AND eq_expr  */
+#line 259 "parse.y"
+                               { (yyval.node) = binop_node(jz, jz_op_bw_and, (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2437 "y.tab.c"
+    break;
+
+  case 102: /* stmt_bw_and_expr: stmt_bw_and_expr BW_AND eq_expr  */
+#line 261 "parse.y"
+                                    { (yyval.node) = binop_node(jz, jz_op_bw_and, (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2443 "y.tab.c"
+    break;
+
+  case 104: /* eq_expr: eq_expr eq_expr_op rel_expr  */
+#line 264 "parse.y"
+                                { (yyval.node) = binop_node(jz, (yyvsp[-1].operation), (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2449 "y.tab.c"
+    break;
+
+  case 105: /* eq_expr: eq_expr neq_expr_op rel_expr  */
+#line 265 "parse.y"
+                                 {
+    /* TODO: Make this transformation elsewhere */
+    (yyval.node) = unop_node(jz, jz_op_not, binop_node(jz, (yyvsp[-1].operation), (yyvsp[-2].node), (yyvsp[0].node)));
+ }
+#line 2458 "y.tab.c"
+    break;
+
+  case 107: /* stmt_eq_expr: stmt_eq_expr eq_expr_op rel_expr  */
+#line 270 "parse.y"
+                                     { (yyval.node) = binop_node(jz, (yyvsp[-1].operation), (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2464 "y.tab.c"
+    break;
+
+  case 108: /* stmt_eq_expr: stmt_eq_expr neq_expr_op rel_expr  */
+#line 271 "parse.y"
+                                      {
+    (yyval.node) = unop_node(jz, jz_op_not, binop_node(jz, (yyvsp[-1].operation), (yyvsp[-2].node), (yyvsp[0].node)));
+ }
+#line 2472 "y.tab.c"
+    break;
+
+  case 109: /* eq_expr_op: EQ_EQ  */
+#line 275 "parse.y"
+                  { (yyval.operation) = jz_op_equals; }
+#line 2478 "y.tab.c"
+    break;
+
+  case 110: /* eq_expr_op: STRICT_EQ  */
+#line 276 "parse.y"
+              { (yyval.operation) = jz_op_strict_eq; }
+#line 2484 "y.tab.c"
+    break;
+
+  case 111: /* neq_expr_op: NOT_EQ  */
+#line 278 "parse.y"
+                    { (yyval.operation) = jz_op_equals; }
+#line 2490 "y.tab.c"
+    break;
+
+  case 112: /* neq_expr_op: NOT_STRICT_EQ  */
+#line 279 "parse.y"
+                  { (yyval.operation) = jz_op_strict_eq; }
+#line 2496 "y.tab.c"
+    break;
+
+  case 114: /* rel_expr: rel_expr rel_expr_op shift_expr  */
+#line 283 "parse.y"
+                                    { (yyval.node) = binop_node(jz, (yyvsp[-1].operation), (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2502 "y.tab.c"
+    break;
+
+  case 116: /* stmt_rel_expr: stmt_rel_expr rel_expr_op shift_expr  */
+#line 285 "parse.y"
+                                         { (yyval.node) = binop_node(jz, (yyvsp[-1].operation), (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2508 "y.tab.c"
+    break;
+
+  case 117: /* rel_expr_op: LESS_THAN  */
+#line 287 "parse.y"
+                       { (yyval.operation) = jz_op_lt; }
+#line 2514 "y.tab.c"
+    break;
+
+  case 118: /* rel_expr_op: GREATER_THAN  */
+#line 288 "parse.y"
+                 { (yyval.operation) = jz_op_gt; }
+#line 2520 "y.tab.c"
+    break;
+
+  case 119: /* rel_expr_op: LT_EQ  */
+#line 289 "parse.y"
+                 { (yyval.operation) = jz_op_lt_eq; }
+#line 2526 "y.tab.c"
+    break;
+
+  case 120: /* rel_expr_op: GT_EQ  */
+#line 290 "parse.y"
+                 { (yyval.operation) = jz_op_gt_eq; }
+#line 2532 "y.tab.c"
+    break;
+
+  case 122: /* shift_expr: shift_expr shift_expr_op add_expr  */
+#line 294 "parse.y"
+                                      { (yyval.node) = binop_node(jz, (yyvsp[-1].operation), (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2538 "y.tab.c"
+    break;
+
+  case 124: /* stmt_shift_expr: stmt_shift_expr shift_expr_op add_expr  */
+#line 296 "parse.y"
+                                           { (yyval.node) = binop_node(jz, (yyvsp[-1].operation), (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2544 "y.tab.c"
+    break;
+
+  case 125: /* shift_expr_op: LSHIFT  */
+#line 298 "parse.y"
+                      { (yyval.operation) = jz_op_lshift; }
+#line 2550 "y.tab.c"
+    break;
+
+  case 126: /* shift_expr_op: RSHIFT  */
+#line 299 "parse.y"
+            { (yyval.operation) = jz_op_rshift; }
+#line 2556 "y.tab.c"
+    break;
+
+  case 127: /* shift_expr_op: URSHIFT  */
+#line 300 "parse.y"
+            { (yyval.operation) = jz_op_urshift; }
+#line 2562 "y.tab.c"
+    break;
+
+  case 129: /* add_expr: add_expr add_expr_op mult_expr  */
+#line 304 "parse.y"
+                                   { (yyval.node) = binop_node(jz, (yyvsp[-1].operation), (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2568 "y.tab.c"
+    break;
+
+  case 131: /* stmt_add_expr: stmt_add_expr add_expr_op mult_expr  */
+#line 306 "parse.y"
+                                        { (yyval.node) = binop_node(jz, (yyvsp[-1].operation), (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2574 "y.tab.c"
+    break;
+
+  case 132: /* add_expr_op: PLUS  */
+#line 308 "parse.y"
+                  { (yyval.operation) = jz_op_add; }
+#line 2580 "y.tab.c"
+    break;
+
+  case 133: /* add_expr_op: MINUS  */
+#line 309 "parse.y"
+          { (yyval.operation) = jz_op_sub; }
+#line 2586 "y.tab.c"
+    break;
+
+  case 135: /* mult_expr: mult_expr mult_expr_op unary_expr  */
+#line 313 "parse.y"
+                                      { (yyval.node) = binop_node(jz, (yyvsp[-1].operation), (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2592 "y.tab.c"
+    break;
+
+  case 137: /* stmt_mult_expr: stmt_mult_expr mult_expr_op unary_expr  */
+#line 315 "parse.y"
+                                           { (yyval.node) = binop_node(jz, (yyvsp[-1].operation), (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2598 "y.tab.c"
+    break;
+
+  case 138: /* mult_expr_op: TIMES  */
+#line 317 "parse.y"
+                    { (yyval.operation) = jz_op_times; }
+#line 2604 "y.tab.c"
+    break;
+
+  case 139: /* mult_expr_op: DIV  */
+#line 318 "parse.y"
+        { (yyval.operation) = jz_op_div; }
+#line 2610 "y.tab.c"
+    break;
+
+  case 140: /* mult_expr_op: MOD  */
+#line 319 "parse.y"
+        { (yyval.operation) = jz_op_mod; }
+#line 2616 "y.tab.c"
+    break;
+
+  case 142: /* unary_expr: unary_expr_op unary_expr  */
+#line 323 "parse.y"
+                             { (yyval.node) = unop_node(jz, (yyvsp[-1].operation), (yyvsp[0].node)); }
+#line 2622 "y.tab.c"
+    break;
+
+  case 144: /* stmt_unary_expr: unary_expr_op unary_expr  */
+#line 325 "parse.y"
+                             { (yyval.node) = unop_node(jz, (yyvsp[-1].operation), (yyvsp[0].node)); }
+#line 2628 "y.tab.c"
+    break;
+
+  case 145: /* unary_expr_op: PLUS  */
+#line 327 "parse.y"
+                    { (yyval.operation) = jz_op_un_add; }
+#line 2634 "y.tab.c"
+    break;
+
+  case 146: /* unary_expr_op: MINUS  */
+#line 328 "parse.y"
+                { (yyval.operation) = jz_op_un_sub; }
+#line 2640 "y.tab.c"
+    break;
+
+  case 147: /* unary_expr_op: BW_NOT  */
+#line 329 "parse.y"
+                { (yyval.operation) = jz_op_bw_not; }
+#line 2646 "y.tab.c"
+    break;
+
+  case 148: /* unary_expr_op: NOT  */
+#line 330 "parse.y"
+                { (yyval.operation) = jz_op_not; }
+#line 2652 "y.tab.c"
+    break;
+
+  case 149: /* unary_expr_op: PLUS_PLUS  */
+#line 331 "parse.y"
+                { (yyval.operation) = jz_op_pre_inc; }
+#line 2658 "y.tab.c"
+    break;
+
+  case 150: /* unary_expr_op: MINUS_MINUS  */
+#line 332 "parse.y"
+                { (yyval.operation) = jz_op_pre_dec; }
+#line 2664 "y.tab.c"
+    break;
+
+  case 152: /* postfix_expr: left_hand_expr postfix_expr_op  */
+#line 336 "parse.y"
+                                   { (yyval.node) = unop_node(jz, (yyvsp[0].operation), (yyvsp[-1].node)); }
+#line 2670 "y.tab.c"
+    break;
+
+  case 154: /* stmt_postfix_expr: stmt_left_hand_expr postfix_expr_op  */
+#line 338 "parse.y"
+                                        { (yyval.node) = unop_node(jz, (yyvsp[0].operation), (yyvsp[-1].node)); }
+#line 2676 "y.tab.c"
+    break;
+
+  case 155: /* postfix_expr_op: PLUS_PLUS  */
+#line 340 "parse.y"
+                           { (yyval.operation) = jz_op_post_inc; }
+#line 2682 "y.tab.c"
+    break;
+
+  case 156: /* postfix_expr_op: MINUS_MINUS  */
+#line 341 "parse.y"
+                { (yyval.operation) = jz_op_post_dec; }
+#line 2688 "y.tab.c"
+    break;
+
+  case 161: /* call_expr: call_or_member_expr arguments  */
+#line 347 "parse.y"
+                                         { (yyval.node) = CONS(jz_enum_new(jz, jz_parse_call), CONS((yyvsp[-1].node), (yyvsp[0].node))); }
+#line 2694 "y.tab.c"
+    break;
+
+  case 162: /* call_expr: call_expr member_accessor  */
+#line 348 "parse.y"
+                              { (yyval.node) = binop_node(jz, jz_op_index, (yyvsp[-1].node), (yyvsp[0].node)); }
+#line 2700 "y.tab.c"
+    break;
+
+  case 163: /* stmt_call_expr: stmt_call_or_member_expr arguments  */
+#line 349 "parse.y"
+                                                   { (yyval.node) = CONS(jz_enum_new(jz, jz_parse_call), CONS((yyvsp[-1].node), (yyvsp[0].node))); }
+#line 2706 "y.tab.c"
+    break;
+
+  case 164: /* stmt_call_expr: stmt_call_expr member_accessor  */
+#line 350 "parse.y"
+                                   { (yyval.node) = binop_node(jz, jz_op_index, (yyvsp[-1].node), (yyvsp[0].node)); }
+#line 2712 "y.tab.c"
+    break;
+
+  case 165: /* arguments: LPAREN RPAREN  */
+#line 352 "parse.y"
+                         { (yyval.node) = NULL; }
+#line 2718 "y.tab.c"
+    break;
+
+  case 166: /* arguments: LPAREN argument_list RPAREN  */
+#line 353 "parse.y"
+                                { (yyval.node) = jz_list_reverse(jz, (yyvsp[-1].node)); }
+#line 2724 "y.tab.c"
+    break;
+
+  case 167: /* argument_list: assign_expr  */
+#line 355 "parse.y"
+                           { (yyval.node) = CONS((yyvsp[0].node), NULL); }
+#line 2730 "y.tab.c"
+    break;
+
+  case 168: /* argument_list: argument_list COMMA assign_expr  */
+#line 356 "parse.y"
+                                    { (yyval.node) = CONS((yyvsp[0].node), (yyvsp[-2].node)); }
+#line 2736 "y.tab.c"
+    break;
+
+  case 177: /* member_expr: member_expr member_accessor  */
+#line 365 "parse.y"
+                                { (yyval.node) = binop_node(jz, jz_op_index, (yyvsp[-1].node), (yyvsp[0].node)); }
+#line 2742 "y.tab.c"
+    break;
+
+  case 179: /* stmt_member_expr: stmt_member_expr member_accessor  */
+#line 367 "parse.y"
+                                     { (yyval.node) = binop_node(jz, jz_op_index, (yyvsp[-1].node), (yyvsp[0].node)); }
+#line 2748 "y.tab.c"
+    break;
+
+  case 180: /* member_accessor: LSQUARE expr RSQUARE  */
+#line 369 "parse.y"
+                                      { (yyval.node) = (yyvsp[-1].node); }
+#line 2754 "y.tab.c"
+    break;
+
+  case 181: /* member_accessor: DOT identifier  */
+#line 371 "parse.y"
+                   {
+    (yyval.node) = jz_enum_wrap(jz, jz_parse_literal, (jz_str*)CADR((yyvsp[0].node)));
+ }
+#line 2762 "y.tab.c"
+    break;
+
+  case 182: /* function_expr: FUNCTION params LCURLY source_elements RCURLY  */
+#line 375 "parse.y"
+                                                             {
+  (yyval.node) = jz_list(jz, 3, jz_enum_new(jz, jz_parse_func), (yyvsp[-3].node), (yyvsp[-1].node));
+ }
+#line 2770 "y.tab.c"
+    break;
+
+  case 183: /* params: LPAREN RPAREN  */
+#line 379 "parse.y"
+                      { (yyval.node) = NULL; }
+#line 2776 "y.tab.c"
+    break;
+
+  case 184: /* params: LPAREN param_list RPAREN  */
+#line 380 "parse.y"
+                             { (yyval.node) = jz_list_reverse(jz, (yyvsp[-1].node)); }
+#line 2782 "y.tab.c"
+    break;
+
+  case 185: /* param_list: IDENTIFIER  */
+#line 382 "parse.y"
+                       { (yyval.node) = CONS((yyvsp[0].str), NULL); }
+#line 2788 "y.tab.c"
+    break;
+
+  case 186: /* param_list: param_list COMMA IDENTIFIER  */
+#line 383 "parse.y"
+                                { (yyval.node) = CONS((yyvsp[0].str), (yyvsp[-2].node)); }
+#line 2794 "y.tab.c"
+    break;
+
+  case 191: /* stmt_primary_expr: THIS  */
+#line 387 "parse.y"
+         { (yyval.node) = CONS(jz_enum_new(jz, jz_parse_this), NULL); }
+#line 2800 "y.tab.c"
+    break;
+
+  case 192: /* stmt_primary_expr: LPAREN expr RPAREN  */
+#line 388 "parse.y"
+                       { (yyval.node) = (yyvsp[-1].node); }
+#line 2806 "y.tab.c"
+    break;
+
+  case 193: /* identifier: IDENTIFIER  */
+#line 390 "parse.y"
+                       {
+  (yyval.node) = jz_enum_wrap(jz, jz_parse_identifier, (yyvsp[0].str));
+ }
+#line 2814 "y.tab.c"
+    break;
+
+  case 194: /* literal: literal_tval  */
+#line 394 "parse.y"
+                      { (yyval.node) = jz_enum_wrap(jz, jz_parse_literal, (yyvsp[0].val)); }
+#line 2820 "y.tab.c"
+    break;
+
+  case 195: /* literal_tval: STRING  */
+#line 396 "parse.y"
+                     { (yyval.val) = (jz_val)(yyvsp[0].str); }
+#line 2826 "y.tab.c"
+    break;
+
+  case 196: /* literal_tval: NUMBER  */
+#line 397 "parse.y"
+           { (yyval.val) = jz_wrap_num(jz, (yyvsp[0].num)); }
+#line 2832 "y.tab.c"
+    break;
+
+  case 197: /* literal_tval: INTEGER  */
+#line 398 "parse.y"
+            { (yyval.val) = jz_wrap_int(jz, (yyvsp[0].i)); }
+#line 2838 "y.tab.c"
+    break;
+
+  case 198: /* literal_tval: bool_val  */
+#line 399 "parse.y"
+             { (yyval.val) = jz_wrap_bool(jz, (yyvsp[0].boolean)); }
+#line 2844 "y.tab.c"
+    break;
+
+  case 199: /* literal_tval: NULL_VAL  */
+#line 400 "parse.y"
+             { (yyval.val) = NULL; }
+#line 2850 "y.tab.c"
+    break;
+
+  case 200: /* bool_val: TRUE_VAL  */
+#line 402 "parse.y"
+                   { (yyval.boolean) = jz_true; }
+#line 2856 "y.tab.c"
+    break;
+
+  case 201: /* bool_val: FALSE_VAL  */
+#line 403 "parse.y"
+              { (yyval.boolean) = jz_false; }
+#line 2862 "y.tab.c"
+    break;
+
+  case 202: /* object_literal: LCURLY RCURLY  */
+#line 405 "parse.y"
+                              {
+  (yyval.node) = CONS(jz_enum_new(jz, jz_parse_obj), NULL);
+ }
+#line 2870 "y.tab.c"
+    break;
+
+
+#line 2874 "y.tab.c"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      {
+        yypcontext_t yyctx
+          = {yyssp, yytoken};
+        char const *yymsgp = YY_("syntax error");
+        int yysyntax_error_status;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+        if (yysyntax_error_status == 0)
+          yymsgp = yymsg;
+        else if (yysyntax_error_status == -1)
+          {
+            if (yymsg != yymsgbuf)
+              YYSTACK_FREE (yymsg);
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
+              {
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
+              }
+            else
+              {
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
+              }
+          }
+        yyerror (jz, root, state, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
+      }
+    }
+
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, jz, root, state);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, jz, root, state);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (jz, root, state, YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, jz, root, state);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, jz, root, state);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+  if (yymsg != yymsgbuf)
+    YYSTACK_FREE (yymsg);
+  return yyresult;
+}
+
+#line 409 "parse.y"
+
+
+jz_cons* jz_parse_string(JZ_STATE, const jz_str* code) {
+  jz_cons* root = NULL;
+  jz_lex_state* state = jz_lex_new(jz, code);
+  int result = yyparse(jz, &root, state);
+
+  free(state);
+
+  /* yyparse returns 0 to indicate success. */
+  if (result != 0)
+    return NULL;
+
+#if JZ_DEBUG_PARSE
+  jz_cons_print(jz, root);
+#endif
+
+  return root;
+}
+
+void yyerror(JZ_STATE, jz_cons** root, jz_lex_state* state, const char* msg)
+{
+  fprintf(stderr, "%s\n", msg);
+}
@@ -0,0 +1,228 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_Y_TAB_H_INCLUDED
+# define YY_YY_Y_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    IDENTIFIER = 258,              /* IDENTIFIER  */
+    STRING = 259,                  /* STRING  */
+    INTEGER = 260,                 /* INTEGER  */
+    NUMBER = 261,                  /* NUMBER  */
+    TRUE_VAL = 262,                /* TRUE_VAL  */
+    FALSE_VAL = 263,               /* FALSE_VAL  */
+    NULL_VAL = 264,                /* NULL_VAL  */
+    THIS = 265,                    /* THIS  */
+    RETURN = 266,                  /* RETURN  */
+    VAR = 267,                     /* VAR  */
+    IF = 268,                      /* IF  */
+    ELSE = 269,                    /* ELSE  */
+    DO = 270,                      /* DO  */
+    WHILE = 271,                   /* WHILE  */
+    FOR = 272,                     /* FOR  */
+    SWITCH = 273,                  /* SWITCH  */
+    CASE = 274,                    /* CASE  */
+    DEFAULT = 275,                 /* DEFAULT  */
+    FUNCTION = 276,                /* FUNCTION  */
+    LCURLY = 277,                  /* LCURLY  */
+    RCURLY = 278,                  /* RCURLY  */
+    LPAREN = 279,                  /* LPAREN  */
+    RPAREN = 280,                  /* RPAREN  */
+    LSQUARE = 281,                 /* LSQUARE  */
+    RSQUARE = 282,                 /* RSQUARE  */
+    DOT = 283,                     /* DOT  */
+    SEMICOLON = 284,               /* SEMICOLON  */
+    COMMA = 285,                   /* COMMA  */
+    LESS_THAN = 286,               /* LESS_THAN  */
+    GREATER_THAN = 287,            /* GREATER_THAN  */
+    GT_EQ = 288,                   /* GT_EQ  */
+    LT_EQ = 289,                   /* LT_EQ  */
+    EQ_EQ = 290,                   /* EQ_EQ  */
+    NOT_EQ = 291,                  /* NOT_EQ  */
+    STRICT_EQ = 292,               /* STRICT_EQ  */
+    NOT_STRICT_EQ = 293,           /* NOT_STRICT_EQ  */
+    PLUS = 294,                    /* PLUS  */
+    MINUS = 295,                   /* MINUS  */
+    TIMES = 296,                   /* TIMES  */
+    MOD = 297,                     /* MOD  */
+    PLUS_PLUS = 298,               /* PLUS_PLUS  */
+    MINUS_MINUS = 299,             /* MINUS_MINUS  */
+    LSHIFT = 300,                  /* LSHIFT  */
+    RSHIFT = 301,                  /* RSHIFT  */
+    URSHIFT = 302,                 /* URSHIFT  */
+    BW_AND = 303,                  /* BW_AND  */
+    BW_OR = 304,                   /* BW_OR  */
+    XOR = 305,                     /* XOR  */
+    NOT = 306,                     /* NOT  */
+    BW_NOT = 307,                  /* BW_NOT  */
+    AND = 308,                     /* AND  */
+    OR = 309,                      /* OR  */
+    QUESTION = 310,                /* QUESTION  */
+    COLON = 311,                   /* COLON  */
+    EQUALS = 312,                  /* EQUALS  */
+    PLUS_EQ = 313,                 /* PLUS_EQ  */
+    MINUS_EQ = 314,                /* MINUS_EQ  */
+    TIMES_EQ = 315,                /* TIMES_EQ  */
+    MOD_EQ = 316,                  /* MOD_EQ  */
+    LSHIFT_EQ = 317,               /* LSHIFT_EQ  */
+    RSHIFT_EQ = 318,               /* RSHIFT_EQ  */
+    URSHIFT_EQ = 319,              /* URSHIFT_EQ  */
+    BW_AND_EQ = 320,               /* BW_AND_EQ  */
+    BW_OR_EQ = 321,                /* BW_OR_EQ  */
+    XOR_EQ = 322,                  /* XOR_EQ  */
+    DIV = 323,                     /* DIV  */
+    DIV_EQ = 324                   /* DIV_EQ  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 257
+#define IDENTIFIER 258
+#define STRING 259
+#define INTEGER 260
+#define NUMBER 261
+#define TRUE_VAL 262
+#define FALSE_VAL 263
+#define NULL_VAL 264
+#define THIS 265
+#define RETURN 266
+#define VAR 267
+#define IF 268
+#define ELSE 269
+#define DO 270
+#define WHILE 271
+#define FOR 272
+#define SWITCH 273
+#define CASE 274
+#define DEFAULT 275
+#define FUNCTION 276
+#define LCURLY 277
+#define RCURLY 278
+#define LPAREN 279
+#define RPAREN 280
+#define LSQUARE 281
+#define RSQUARE 282
+#define DOT 283
+#define SEMICOLON 284
+#define COMMA 285
+#define LESS_THAN 286
+#define GREATER_THAN 287
+#define GT_EQ 288
+#define LT_EQ 289
+#define EQ_EQ 290
+#define NOT_EQ 291
+#define STRICT_EQ 292
+#define NOT_STRICT_EQ 293
+#define PLUS 294
+#define MINUS 295
+#define TIMES 296
+#define MOD 297
+#define PLUS_PLUS 298
+#define MINUS_MINUS 299
+#define LSHIFT 300
+#define RSHIFT 301
+#define URSHIFT 302
+#define BW_AND 303
+#define BW_OR 304
+#define XOR 305
+#define NOT 306
+#define BW_NOT 307
+#define AND 308
+#define OR 309
+#define QUESTION 310
+#define COLON 311
+#define EQUALS 312
+#define PLUS_EQ 313
+#define MINUS_EQ 314
+#define TIMES_EQ 315
+#define MOD_EQ 316
+#define LSHIFT_EQ 317
+#define RSHIFT_EQ 318
+#define URSHIFT_EQ 319
+#define BW_AND_EQ 320
+#define BW_OR_EQ 321
+#define XOR_EQ 322
+#define DIV 323
+#define DIV_EQ 324
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 46 "parse.y"
+
+  struct jz_cons* node;
+  jz_str* str;
+  double num;
+  int i;
+  char boolean;
+  int operation;
+  jz_val val;
+  char none;
+
+#line 216 "y.tab.h"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+
+
+
+
+
+#endif /* !YY_YY_Y_TAB_H_INCLUDED  */
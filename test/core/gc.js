@@ -0,0 +1,19 @@
+var before = gc.stats();
+for (var i = 0; i < 20000; i++) ({}).x = "s" + i;
+
+var kept = {};
+gc.collect();
+var after = gc.stats();
+
+var res = after.cycles > before.cycles && after.freed > before.freed;
+res = res && after.minors >= before.minors && after.markTime >= 0;
+res = res && after.allocated <= after.heapSize;
+res = res && after.lastFreed > 0 && after.objects.obj > 0;
+res = res && after.objects.bytecode > 0 && after.objects.num >= 0;
+
+/* Taking a snapshot leaves the collector ready to carry on. */
+res = res && gc.snapshot("/dev/null");
+res = res && !gc.snapshot("/nonexistent/dir/snapshot");
+for (i = 0; i < 20000; i++) ({}).x = "t" + i;
+gc.collect();
+return res && gc.stats().cycles > after.cycles;
@@ -0,0 +1,11 @@
+/* Extra arguments are dropped and missing ones are undefined. */
+var f = function(a, b) { var c = 3; return a + b + c; };
+var g = function(a) { var b = function() { return a; }; return b(); };
+var h = function(a) { var c; return c; };
+
+var res = f(1, 2) == 6 && f(1, 2, 100, 200) == 6 && isNaN(f(1));
+res = res && g(7, 8, 9) == 7 && isNaN(h(1, 2) + 1);
+
+var sum = 0;
+for (var i = 0; i < 1000; i++) sum = sum + f(i, 1, i);
+return res && sum == 503500;
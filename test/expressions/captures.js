@@ -0,0 +1,51 @@
+/* Variables that are never assigned to are copied into closures. */
+var add = function(a) {
+  return function(b) {
+    return function(c) { return a + b + c; };
+  };
+};
+
+/* A mix of copied and boxed variables. */
+var running = function(step) {
+  var total = 0;
+  return function(n) { total = total + n * step; return total; };
+};
+
+/* Assigned to in an inner function, so it's boxed. */
+var shared = function(x) {
+  var set = function(v) { x = v; };
+  var get = function() { return x; };
+  set(7);
+  return get();
+};
+
+/* The same nesting, with every variable assigned to and so boxed. */
+var boxed = function(a) {
+  a = a * 2;
+  return function(b) {
+    b = b * 2;
+    return function(c) { c = c * 2; return a + b + c; };
+  };
+};
+
+/* Never assigned to, so always undefined. */
+var unset = function() {
+  var u;
+  return function() { return u; };
+};
+
+/* An inner variable of the same name doesn't get the copy. */
+var shadow = function(y) {
+  return function(z) { var y = z; return y; };
+};
+
+var i;
+var make = function(k) { return function() { return k; }; };
+var sum = 0;
+for (i = 0; i < 100; i++) sum = sum + make(i)();
+
+var r = running(2);
+r(1);
+
+return add(1)(2)(3) == 6 && boxed(1)(2)(3) == 12 && r(2) == 6 && shared(1) == 7 &&
+  unset()() === undefined && shadow(1)(2) == 2 && sum == 4950;
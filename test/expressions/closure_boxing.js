@@ -0,0 +1,51 @@
+/* Captured variables stay in the frame until a closure is made,
+   then move into a box that the closure shares with the frame. */
+var make = function(n, early) {
+  var count = n;
+  var get;
+  if (early) get = function() { return count; };
+  count = count + 1;
+  if (!early) get = function() { return count; };
+  count = count + 1;
+  return get;
+};
+
+/* The middle function captures nothing of its own,
+   but the inner one still sees the outer one's variables. */
+var outer = function(x) {
+  var middle = function() {
+    return function() { x = x + 1; return x; };
+  };
+  var inner = middle();
+  inner();
+  return inner() + x;
+};
+
+var adders = function() {
+  var total = 0;
+  var add = function(n) { total = total + n; };
+  var i;
+  for (i = 0; i < 1000; i++) add(i);
+  return total;
+};
+
+/* Functions that declare captured variables but make no closure. */
+var unused = function(n) {
+  var y = n * 2;
+  if (n < 0) return function() { return y; };
+  return y;
+};
+
+/* Captured parameters of an inner function
+   mustn't land on the outer function's captured variables. */
+var params = function(a) {
+  a = a + 1;
+  var g = function(c) {
+    var k = function() { c = c + 1; return a + c; };
+    return k();
+  };
+  return g(10) + a;
+};
+
+return params(100) == 213 && make(1, true)() == 3 && make(1, false)() == 3 &&
+  outer(10) == 24 && adders() == 499500 && unused(21) == 42;
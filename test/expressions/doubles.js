@@ -0,0 +1,9 @@
+var a = 0.5, b = -2.25, n = 0/0, z = -0, inf = 1/0;
+var s = 0;
+
+for (var i = 0; i < 10; i++) s += 0.1;
+
+return a + b == -1.75 && a * 4 == 2 && (b + "") == "-2.25" &&
+  n != n && !(n < 1) && !n && -n != -n &&
+  1/z == -inf && -inf < b && -1e300 * 1e300 == -inf &&
+  s > 0.99 && s < 1.01 && (0.75 | 0) == 0 && !!b;
@@ -0,0 +1,11 @@
+/* Calls between script functions don't use the C stack,
+   so recursion goes as deep as the Jazz stack allows. */
+var depth = function(n) { return n == 0 ? 0 : 1 + depth(n - 1); };
+var even = function(n) { return n == 0 ? true : odd(n - 1); };
+var odd = function(n) { return n == 0 ? false : even(n - 1); };
+
+/* Returning from a nested call has to put the result in the right place. */
+var add = function(a, b) { return a + b; };
+var x = add(1, add(2, add(3, 4))) * add(depth(5), 1);
+
+return depth(100000) == 100000 && even(1000) && odd(999) && x == 60;
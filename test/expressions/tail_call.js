@@ -0,0 +1,35 @@
+/* Calls in return statements reuse the caller's frame,
+   so they can go far deeper than the Jazz stack would otherwise allow. */
+var count = function(n, acc) {
+  if (n == 0) return acc;
+  return count(n - 1, acc + 1);
+};
+
+var even = function(n) {
+  if (n == 0) return true;
+  return odd(n - 1);
+};
+var odd = function(n) {
+  if (n == 0) return false;
+  return even(n - 1);
+};
+
+/* Captured variables outlive the frame they were declared in. */
+var counter = function() {
+  var calls = 0;
+  var loop = function(n) {
+    calls = calls + 1;
+    if (n == 0) return calls;
+    return loop(n - 1);
+  };
+  return loop;
+};
+
+/* Too many arguments to copy aside, so this is an ordinary call. */
+var many = function(a, b, c, d, e, f, g, h, i) {
+  if (a == 0) return b + c + d + e + f + g + h + i;
+  return many(a - 1, b, c, d, e, f, g, h, i);
+};
+
+return count(100000, 0) == 100000 && !even(100001) &&
+  counter()(50000) == 50001 && many(100, 1, 1, 1, 1, 1, 1, 1, 1) == 8;
@@ -0,0 +1,27 @@
+/* The workload for the sweeping tests: young objects that only old ones
+   refer to, as in generations.js, then enough old objects dying
+   for major collections to have plenty to sweep.
+   The function returns whether everything that should've survived did. */
+return function() {
+  var holder = {};
+  var last;
+  var keep = function(v) { last = v; };
+
+  for (var i = 0; i < 20000; i++) {
+    var o = {};
+    o.n = i;
+    o.s = "s" + i;
+    holder.latest = o;
+    if (i % 1000 == 0) holder["k" + i] = o;
+    keep("v" + i);
+  }
+
+  for (var j = 0; j < 10; j++) {
+    var old = {};
+    for (i = 0; i < 5000; i++) old["o" + i] = "o" + i;
+    for (i = 0; i < 5000; i++) ({}).x = "w" + i;
+  }
+
+  return holder.latest.n == 19999 && holder.latest.s == "s19999" &&
+    holder.k5000.n == 5000 && last == "v19999";
+};
@@ -0,0 +1,31 @@
+var o = {};
+o.ab = 1;
+
+/* Computed keys find properties added under literal names, and vice versa. */
+var res = o["a" + "b"] == 1 && o["a" + "c"] == undefined;
+o["c" + "d"] = 2;
+res = res && o.cd == 2;
+
+/* Churn through enough garbage keys for them to be collected,
+   then make sure the same names still work afterwards. */
+for (var round = 0; round < 3; round++) {
+  var tmp = {};
+  for (var i = 0; i < 2000; i++) tmp["key" + i] = i;
+  res = res && tmp.key1999 == 1999 && tmp["key" + 1000] == 1000;
+}
+
+/* Removed atoms' slots are reused, so the table is sized by the atoms
+   that are alive rather than by all the ones there have ever been.
+   Each round's keys are collected before the next round's are made. */
+for (round = 0; round < 20; round++) {
+  tmp = {};
+  for (i = 0; i < 5000; i++) tmp["r" + round + "_" + i] = i;
+  gc.collect();
+}
+res = res && gc.stats().atomCapacity <= 65536;
+
+var again = {};
+again["key" + 5] = "five";
+res = res && again.key5 == "five" && again["key5"] == "five";
+
+return res && o.ab == 1 && o["cd"] == 2;
@@ -0,0 +1,14 @@
+var churn = load("test/objects/_churn.js");
+
+/* Normally the garbage is swept on this thread. */
+gc.setBackgroundSweep(false);
+gc.collect();
+var before = gc.stats().backgroundFreed;
+var res = churn() && gc.stats().backgroundFreed == before;
+
+/* In the background, the sweeper thread hands over the slots it frees.
+   This needs a build with GC_THREADS above 1, as is the default. */
+gc.setBackgroundSweep(true);
+res = res && churn();
+gc.collect();
+return res && gc.stats().backgroundFreed > before;
@@ -0,0 +1,22 @@
+/* An object that survives long enough to become old. */
+var holder = {};
+for (var i = 0; i < 20000; i++) ({}).x = i;
+
+/* Young objects referred to only by old objects or closure variables
+   have to survive the minor collections that follow. */
+var last;
+var keep = function(v) { last = v; };
+
+for (var i = 0; i < 20000; i++) {
+  var o = {};
+  o.n = i;
+  o.s = "s" + i;
+  holder.latest = o;
+  if (i % 1000 == 0) holder["k" + i] = o;
+  keep("v" + i);
+}
+for (var i = 0; i < 20000; i++) ({}).x = "w" + i;
+
+var res = holder.latest.n == 19999 && holder.latest.s == "s19999";
+res = res && holder.k5000.n == 5000 && holder.k5000.s == "s5000";
+return res && last == "v19999";
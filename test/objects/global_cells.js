@@ -0,0 +1,21 @@
+var later = function () { return definedLater; };
+var set = function (v) { definedLater = v; };
+
+var res = later() == undefined && isNaN(NaN) && !isNaN(1);
+
+set(5);
+res = res && later() == 5 && this["definedLater"] == 5;
+
+this["definedLater"] = "dynamic";
+res = res && later() == "dynamic";
+
+/* Globals that don't exist fall back to the global object's prototype. */
+({}).prototype.fromProto = "proto";
+res = res && fromProto == "proto";
+fromProto = "own";
+res = res && fromProto == "own" && ({}).fromProto == "proto";
+
+total = 0;
+for (var i = 0; i < 100; i++) total = total + i;
+
+return res && total == 4950 && this["total"] == 4950;
@@ -0,0 +1,48 @@
+var get = function (o) { return o.x; };
+var set = function (o, v) { o.x = v; };
+var inherited = function (o) { return o.shared; };
+
+var i, res = true;
+var shapes = function (n) {
+  var o = {};
+  for (var j = 0; j < n; j++) o["p" + j] = j;
+  o.x = n;
+  return o;
+};
+
+/* More shapes than one cache holds, all seen at the same sites. */
+for (var round = 0; round < 20; round++) {
+  for (i = 0; i < 7; i++) {
+    var o = shapes(i);
+    res = res && get(o) == i;
+    set(o, -i);
+    res = res && get(o) == -i && o["x"] == -i;
+  }
+}
+
+var proto = ({}).prototype;
+proto.shared = "proto";
+var a = {};
+for (i = 0; i < 10; i++) res = res && inherited(a) == "proto";
+
+proto.shared = "changed";
+res = res && inherited(a) == "changed";
+
+proto.other = 1;
+res = res && inherited(a) == "changed";
+
+a.shared = "own";
+res = res && inherited(a) == "own" && inherited({}) == "changed";
+
+/* Objects with their own hash tables, grown after they're cached. */
+var big = shapes(40);
+for (i = 0; i < 10; i++) res = res && get(big) == 40;
+for (i = 0; i < 40; i++) big["q" + i] = i;
+set(big, "big");
+res = res && get(big) == "big" && big.q39 == 39;
+
+counter = 0;
+var bump = function () { counter = counter + 1; return counter; };
+for (i = 0; i < 50; i++) bump();
+
+return res && counter == 50 && this["counter"] == 50;
@@ -0,0 +1,16 @@
+var churn = load("test/objects/_churn.js");
+
+/* Background sweeping would take precedence. */
+gc.setBackgroundSweep(false);
+
+/* Normally the garbage is swept at safepoints once marking's done. */
+gc.setLazySweep(false);
+gc.collect();
+var before = gc.stats().lazyFreed;
+var res = churn() && gc.stats().lazyFreed == before;
+
+/* Lazily, it's left where it is,
+   and the allocator sweeps up slots to reuse as it needs them. */
+gc.setLazySweep(true);
+res = res && churn();
+return res && gc.stats().lazyFreed > before;
@@ -0,0 +1,30 @@
+var make = function (n, reverse) {
+  var o = {};
+  for (var i = 0; i < n; i++) {
+    if (reverse) o["p" + (n - i - 1)] = i;
+    else o["p" + i] = i;
+  }
+  return o;
+};
+
+var res = true, a, b, c;
+
+for (var round = 0; round < 200; round++) {
+  a = make(3, false);
+  b = make(3, true);
+  c = make(12, false);
+
+  res = res && a.p0 == 0 && a.p2 == 2 && b.p0 == 2 && b.p2 == 0;
+  res = res && c.p3 == 3 && c.p4 == 4 && c.p11 == 11 && c.p12 == undefined;
+}
+
+a.p1 = "changed";
+res = res && a.p1 == "changed" && make(3, false).p1 == 1;
+
+/* Past the largest shape, objects switch to their own tables. */
+var big = make(40, false);
+big.p39 = -1;
+big.extra = "x";
+res = res && big.p0 == 0 && big.p33 == 33 && big.p39 == -1 && big.extra == "x";
+
+return res && c.prototype == a.prototype;
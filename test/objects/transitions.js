@@ -0,0 +1,26 @@
+/* Each of these objects gets a key that no other object has.
+   Shapes stop adding transitions after JZ_SHAPE_MAX_TRANSITIONS
+   and the objects get their own tables instead,
+   so this takes well under a second rather than most of a minute. */
+var before = gc.stats().objects;
+var res = true;
+
+for (var i = 0; i < 100000; i++) {
+  var t = {};
+  t["k" + i] = i;
+  res = res && t["k" + i] == i;
+}
+gc.collect();
+
+/* Transitions are weak, so the shapes die along with the objects,
+   and the keys' atoms with them. */
+var after = gc.stats().objects;
+res = res && after.shape < before.shape + 100;
+res = res && after.str < before.str + 100;
+
+/* Dead transitions are unlinked, so new ones can be made in their place. */
+var a = {}, b = {};
+a.k5 = 5;
+b.k5 = 6;
+b.k6 = 7;
+return res && a.k5 == 5 && b.k5 == 6 && b.k6 == 7 && t.k99999 == 99999;
@@ -0,0 +1,20 @@
+var a = 7, b = -3, zero = 0, big = 4294967297, res = true;
+
+res = res && a / 7 == 1 && a / 2 == 3.5 && 1 / (zero / b) < 0;
+res = res && a % 3 == 1 && b % 2 == -1;
+res = res && a % -3 == 1 && 1 / (zero % 5) > 0;
+
+res = res && (big | 0) == 1 && (big & 3) == 1 && (big ^ 1) == 0;
+res = res && (b >>> 0) == 4294967293 && (b >> 1) == -2;
+res = res && (1 << 31) == -2147483648 && (a << 33) == 14;
+res = res && ~a == -8 && ~big == -2;
+
+res = res && b < a && !(a < b) && a > b && a <= 7 && b >= -3;
+res = res && !(a < a) && a <= a && !(a < zero / zero);
+res = res && a == 7 && a === 7 && a != b && -big < b;
+
+res = res && -a == -7 && 1 / -zero < 0 && +a === 7;
+
+var n = 0;
+for (var i = 10; i >= -10; i--) if (i % 2 == 0) n++;
+return res && n == 11;
@@ -0,0 +1,22 @@
+var big = 1073741824, res = true;
+
+/* Tagged ints spill over into doubles instead of wrapping. */
+var sq = big * big;
+res = res && sq == 1152921504606846976 && sq / big == big;
+res = res && big * big * big > sq;
+
+var sum = 0, i;
+for (i = 0; i < 40; i++) sum = sum + sum + 1;
+res = res && sum == 1099511627775 && sum + 1 == 1099511627776;
+for (i = 0; i < 20; i++) sum = sum * 4;
+res = res && sum > 1e23 && sum - sum == 0;
+
+var neg = -big;
+res = res && neg - big == -2147483648 && neg * 4 == -4294967296;
+
+/* 0 times a negative number is -0. */
+var zero = 0, minus = -3;
+res = res && 1 / (zero * minus) < 0 && 1 / (minus * zero) < 0;
+res = res && 1 / (zero * 3) > 0 && 1 / (zero - zero) > 0;
+
+return res && 4294967295 + 1 == 4294967296;
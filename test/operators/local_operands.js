@@ -0,0 +1,29 @@
+var f = function (a, b) {
+  var r = true, x;
+
+  x = a | b;   r = r && x == 7;
+  x = a ^ 1;   r = r && x == 2;
+  x = 6 & b;   r = r && x == 4;
+  x = a == 3;  r = r && x;
+  x = a === b; r = r && !x;
+  x = a < b;   r = r && x;
+  x = a > b;   r = r && !x;
+  x = a <= 3;  r = r && x;
+  x = b >= 5;  r = r && !x;
+  x = a << 2;  r = r && x == 12;
+  x = -b >> 1; r = r && x == -2;
+  x = b >>> 1; r = r && x == 2;
+  x = a + b;   r = r && x == 7;
+  x = "a" + a; r = r && x == "a3";
+  x = a - b;   r = r && x == -1;
+  x = a * b;   r = r && x == 12;
+  x = b / 8;   r = r && x == 0.5;
+  x = b % a;   r = r && x == 1;
+  x = a;       r = r && x == 3;
+  x *= x;      r = r && x == 9;
+  x -= 0.5;    r = r && x == 8.5;
+
+  return r;
+};
+
+return f(3, 4);
@@ -0,0 +1,19 @@
+var sum = 0, count = 0;
+var f = function (n, step) {
+  var total = 0;
+
+  for (var i = 0; i < n; i++) count++;
+  for (var j = n; 0 < j; j--) total += j;
+  for (var k = 0; k < 10; k += step) count--;
+  for (var m = 0; m < undefined; m++) return false;
+
+  return total;
+};
+
+var s = "a";
+s++;
+s += 1.5;
+
+sum = f(5, 2);
+return sum == 15 && count == 0 && s == "a11.5" && f(0, 1) == 0 &&
+  count == -10;